@@ -0,0 +1,349 @@
+// db_columnar.hpp
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "db_field.hpp"
+#include "db_record.hpp"
+
+namespace drug_lib::common::database
+{
+    /// @brief Column of ColumnarResult. Values are kept in one contiguous vector chosen by the sql type:
+    /// INT, BIGINT and TIMESTAMP(clock ticks since epoch) - integers, DOUBLE_PRECISION - reals, BOOLEAN - booleans,
+    /// TEXT, UUID and JSONB - one text arena with offsets. Null cells keep a default value and are marked in a bitmap
+    class Column final
+    {
+    public:
+        /// @throws std::invalid_argument If the type is UNSUPPORTED
+        Column(std::string name, const SqlType type)
+            : name_(std::move(name)), type_(type), storage_(storage_of(type))
+        {
+        }
+
+        [[nodiscard]] const std::string& name() const
+        {
+            return name_;
+        }
+
+        [[nodiscard]] SqlType type() const
+        {
+            return type_;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return size_;
+        }
+
+        [[nodiscard]] bool is_null(const std::size_t row) const
+        {
+            return (nulls_[row / 64] >> (row % 64) & 1) != 0;
+        }
+
+        [[nodiscard]] std::size_t null_count() const
+        {
+            return null_count_;
+        }
+
+        /// @throws std::logic_error If the column isn't INT, BIGINT or TIMESTAMP
+        [[nodiscard]] std::span<const int64_t> integers() const
+        {
+            require(Storage::INTEGER);
+            return integers_;
+        }
+
+        /// @throws std::logic_error If the column isn't DOUBLE_PRECISION
+        [[nodiscard]] std::span<const double> reals() const
+        {
+            require(Storage::REAL);
+            return reals_;
+        }
+
+        /// @return 0 or 1 per row
+        /// @throws std::logic_error If the column isn't BOOLEAN
+        [[nodiscard]] std::span<const uint8_t> booleans() const
+        {
+            require(Storage::BOOLEAN);
+            return booleans_;
+        }
+
+        /// @return View into the arena, valid while the column is alive and not appended
+        /// @throws std::logic_error If the column isn't TEXT, UUID or JSONB
+        [[nodiscard]] std::string_view text(const std::size_t row) const
+        {
+            require(Storage::TEXT);
+            return std::string_view(arena_).substr(offsets_[row], offsets_[row + 1] - offsets_[row]);
+        }
+
+        /// @throws std::logic_error If the column isn't TIMESTAMP
+        [[nodiscard]] std::chrono::system_clock::time_point timestamp(const std::size_t row) const
+        {
+            if (type_ != SqlType::TIMESTAMP)
+            {
+                throw std::logic_error("Column " + name_ + " isn't a timestamp.\t");
+            }
+            return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(integers_[row]));
+        }
+
+        /// @param text_bytes Expected total size of the texts, used only by text columns
+        void reserve(const std::size_t rows, const std::size_t text_bytes = 0)
+        {
+            nulls_.reserve((rows + 63) / 64);
+            switch (storage_)
+            {
+            case Storage::INTEGER:
+                integers_.reserve(rows);
+                break;
+            case Storage::REAL:
+                reals_.reserve(rows);
+                break;
+            case Storage::BOOLEAN:
+                booleans_.reserve(rows);
+                break;
+            case Storage::TEXT:
+                offsets_.reserve(rows + 1);
+                arena_.reserve(text_bytes);
+                break;
+            }
+        }
+
+        void append_null()
+        {
+            switch (storage_)
+            {
+            case Storage::INTEGER:
+                integers_.push_back(0);
+                break;
+            case Storage::REAL:
+                reals_.push_back(0.);
+                break;
+            case Storage::BOOLEAN:
+                booleans_.push_back(0);
+                break;
+            case Storage::TEXT:
+                offsets_.push_back(arena_.size());
+                break;
+            }
+            mark_row(true);
+        }
+
+        void append_integer(const int64_t value)
+        {
+            require(Storage::INTEGER);
+            integers_.push_back(value);
+            mark_row(false);
+        }
+
+        void append_real(const double value)
+        {
+            require(Storage::REAL);
+            reals_.push_back(value);
+            mark_row(false);
+        }
+
+        void append_boolean(const bool value)
+        {
+            require(Storage::BOOLEAN);
+            booleans_.push_back(value ? 1 : 0);
+            mark_row(false);
+        }
+
+        void append_text(const std::string_view value)
+        {
+            require(Storage::TEXT);
+            arena_.append(value);
+            offsets_.push_back(arena_.size());
+            mark_row(false);
+        }
+
+        void append_timestamp(const std::chrono::system_clock::time_point value)
+        {
+            append_integer(value.time_since_epoch().count());
+        }
+
+        /// @brief Append the value of the owning field, null uuid is appended as null
+        /// @throws std::runtime_error If the field type differs from the column type
+        void append_field(const FieldBase& field)
+        {
+            switch (type_)
+            {
+            case SqlType::INT:
+                append_integer(field.as<int>());
+                break;
+            case SqlType::BIGINT:
+                append_integer(field.as<int64_t>());
+                break;
+            case SqlType::TIMESTAMP:
+                append_timestamp(field.as<std::chrono::system_clock::time_point>());
+                break;
+            case SqlType::DOUBLE_PRECISION:
+                append_real(field.as<double>());
+                break;
+            case SqlType::BOOLEAN:
+                append_boolean(field.as<bool>());
+                break;
+            case SqlType::UUID:
+                if (const auto uuid = field.as<Uuid>(); uuid.is_null())
+                {
+                    append_null();
+                }
+                else
+                {
+                    append_text(uuid.get_id());
+                }
+                break;
+            case SqlType::TEXT:
+            case SqlType::JSONB:
+                append_text(field.to_string());
+                break;
+            case SqlType::UNSUPPORTED:
+                break;
+            }
+        }
+
+    private:
+        enum class Storage
+        {
+            INTEGER,
+            REAL,
+            BOOLEAN,
+            TEXT
+        };
+
+        static Storage storage_of(const SqlType type)
+        {
+            switch (type)
+            {
+            case SqlType::INT:
+            case SqlType::BIGINT:
+            case SqlType::TIMESTAMP:
+                return Storage::INTEGER;
+            case SqlType::DOUBLE_PRECISION:
+                return Storage::REAL;
+            case SqlType::BOOLEAN:
+                return Storage::BOOLEAN;
+            case SqlType::TEXT:
+            case SqlType::UUID:
+            case SqlType::JSONB:
+                return Storage::TEXT;
+            case SqlType::UNSUPPORTED:
+                break;
+            }
+            throw std::invalid_argument("Unsupported column type.\t");
+        }
+
+        void require(const Storage storage) const
+        {
+            if (storage_ != storage)
+            {
+                throw std::logic_error("Column " + name_ + " is stored in another type.\t");
+            }
+        }
+
+        void mark_row(const bool is_null)
+        {
+            if (size_ % 64 == 0)
+            {
+                nulls_.push_back(0);
+            }
+            if (is_null)
+            {
+                nulls_.back() |= uint64_t{1} << (size_ % 64);
+                ++null_count_;
+            }
+            ++size_;
+        }
+
+        std::string name_;
+        SqlType type_;
+        Storage storage_;
+        std::size_t size_ = 0;
+        std::size_t null_count_ = 0;
+        // Bit per row, set for null
+        std::vector<uint64_t> nulls_;
+        std::vector<int64_t> integers_;
+        std::vector<double> reals_;
+        std::vector<uint8_t> booleans_;
+        std::string arena_;
+        // Text of row i is arena_[offsets_[i], offsets_[i + 1])
+        std::vector<std::size_t> offsets_ = {0};
+    };
+
+    /// @brief Result of a select stored by columns. Scanning one column touches linear memory
+    /// instead of a heap object per cell like Record does
+    class ColumnarResult final
+    {
+    public:
+        /// @warning Returned reference is invalidated by adding the next column
+        Column& add_column(std::string name, const SqlType type)
+        {
+            return columns_.emplace_back(std::move(name), type);
+        }
+
+        /// @brief Append the row to the columns. Columns are created by the layout of the first row
+        /// @throws std::invalid_argument If the row layout differs from the columns
+        void append_record(const Record& record)
+        {
+            if (columns_.empty())
+            {
+                columns_.reserve(record.size());
+                for (const auto& field : record)
+                {
+                    add_column(field->get_name(), field->get_sql_type());
+                }
+            }
+            if (record.size() != columns_.size())
+            {
+                throw std::invalid_argument("Record layout differs from the columns.\t");
+            }
+            for (std::size_t i = 0; i < columns_.size(); ++i)
+            {
+                columns_[i].append_field(*record[i]);
+            }
+        }
+
+        [[nodiscard]] std::size_t rows() const
+        {
+            return columns_.empty() ? 0 : columns_.front().size();
+        }
+
+        [[nodiscard]] std::size_t columns_count() const
+        {
+            return columns_.size();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return rows() == 0;
+        }
+
+        [[nodiscard]] const Column& column(const std::size_t idx) const
+        {
+            return columns_.at(idx);
+        }
+
+        /// @throws std::out_of_range If there is no column with the name
+        [[nodiscard]] const Column& column(const std::string_view name) const
+        {
+            const auto it = std::ranges::find(columns_, name, &Column::name);
+            if (it == columns_.end())
+            {
+                throw std::out_of_range("No column " + std::string(name) + " in result.\t");
+            }
+            return *it;
+        }
+
+        [[nodiscard]] auto begin() const { return columns_.cbegin(); }
+        [[nodiscard]] auto end() const { return columns_.cend(); }
+
+    private:
+        std::vector<Column> columns_;
+    };
+}
@@ -26,14 +26,24 @@ namespace drug_lib::common::database
         {
         }
 
+        /// @brief Field equals any of the values, e.g. lookup of a batch by ids. Values are sent as one array parameter
+        FieldCondition(std::unique_ptr<FieldBase> field, std::vector<std::unique_ptr<FieldBase>> values)
+            : field_(std::move(field)), operator_("= ANY"), values_(std::move(values))
+        {
+        }
+
         [[nodiscard]] const std::unique_ptr<FieldBase>& field() const & { return field_; }
         [[nodiscard]] const std::string& op() const & { return operator_; }
+        /// @return Nullptr for the condition with list of values
         [[nodiscard]] const std::unique_ptr<FieldBase>& value() const & { return value_; }
+        [[nodiscard]] const std::vector<std::unique_ptr<FieldBase>>& values() const & { return values_; }
+        [[nodiscard]] bool is_list() const { return value_ == nullptr; }
 
     private:
         std::unique_ptr<FieldBase> field_;
         std::string operator_;
         std::unique_ptr<FieldBase> value_;
+        std::vector<std::unique_ptr<FieldBase>> values_;
     };
 
     class PatternCondition final
@@ -161,6 +171,28 @@ namespace drug_lib::common::database
         std::string pattern_;
     };
 
+    /// @brief Rows matched by full text search or similar by trigrams, ordered by relevance before other orders.
+    /// Relevance is ts_rank plus trigram similarity. Rows get two trailing columns: relevance and exact_match,
+    /// which is true for the rows matched by full text search.
+    /// Similar rows are the ones passing the trigram % operator, i.e. similarity of at least
+    /// pg_trgm.similarity_threshold (0.3 by default), so unlike ordering by distance alone less similar rows are left out
+    class RelevanceCondition final
+    {
+    public:
+        explicit RelevanceCondition(std::string pattern)
+            : pattern_(std::move(pattern))
+        {
+        }
+
+        [[nodiscard]] const std::string& get_pattern() const &
+        {
+            return pattern_;
+        }
+
+    private:
+        std::string pattern_;
+    };
+
     class PageCondition final
     {
     public:
@@ -216,9 +248,45 @@ namespace drug_lib::common::database
         uint32_t offset_; // Starting point in the dataset (calculated as page_number * limit)
     };
 
+    /// @brief Keyset page: rows following the anchor row of the previous page. Rows are ordered by the key
+    /// (by relevance first, if pattern ranking is set), so unlike PageCondition the skipped rows aren't scanned
+    class SeekCondition final
+    {
+    public:
+        ~SeekCondition() = default;
+        SeekCondition(SeekCondition&&) noexcept = default;
+        SeekCondition& operator=(SeekCondition&&) noexcept = default;
+        SeekCondition(const SeekCondition&) = delete;
+        SeekCondition& operator=(const SeekCondition&) = delete;
+
+        /// @param key Unique column of the table
+        /// @param after Key of the anchor row, nullptr for the first page
+        /// @param after_rank Rank of the anchor row, required when the rows are ranked.
+        /// The anchor may be gone by the next page, so its rank isn't looked up
+        SeekCondition(std::unique_ptr<FieldBase> key, std::unique_ptr<FieldBase> after, const uint32_t limit,
+                      const std::optional<double> after_rank = std::nullopt)
+            : key_(std::move(key)), after_(std::move(after)), limit_(limit), after_rank_(after_rank)
+        {
+        }
+
+        [[nodiscard]] const std::unique_ptr<FieldBase>& key() const & { return key_; }
+        [[nodiscard]] const std::unique_ptr<FieldBase>& after() const & { return after_; }
+        [[nodiscard]] uint32_t get_limit() const & { return limit_; }
+        [[nodiscard]] const std::optional<double>& after_rank() const & { return after_rank_; }
+
+    private:
+        std::unique_ptr<FieldBase> key_;
+        std::unique_ptr<FieldBase> after_;
+        uint32_t limit_;
+        std::optional<double> after_rank_;
+    };
+
     class Conditions final
     {
     public:
+        Conditions() = default;
+        Conditions(Conditions&&) noexcept = default;
+        Conditions& operator=(Conditions&&) noexcept = default;
         ~Conditions() = default;
 
         void add_field_condition(FieldCondition&& condition) &
@@ -278,6 +346,24 @@ namespace drug_lib::common::database
             pages_ = condition;
         }
 
+        /// @brief Replaces offset paging, can't be combined with page, order by and similarity conditions
+        void set_seek_condition(SeekCondition&& condition) &
+        {
+            seek_ = std::move(condition);
+        }
+
+        /// @brief Can't be combined with seek condition
+        void set_relevance_condition(RelevanceCondition&& condition) &
+        {
+            relevance_ = std::move(condition);
+        }
+
+        /// @brief Order rows matched by the pattern conditions by relevance(ts_rank) before other orders
+        void set_pattern_ranking(const bool rank) &
+        {
+            rank_patterns_ = rank;
+        }
+
         void pop_field_condition() &
         {
             conditions_.pop_back();
@@ -323,6 +409,16 @@ namespace drug_lib::common::database
             similarity_conditions_.clear();
         }
 
+        void clear_seek_condition() &
+        {
+            seek_.reset();
+        }
+
+        void clear_relevance_condition() &
+        {
+            relevance_.reset();
+        }
+
         [[nodiscard]] const std::vector<FieldCondition>& fields_conditions() const &
         {
             return conditions_;
@@ -348,10 +444,25 @@ namespace drug_lib::common::database
             return similarity_conditions_;
         }
 
+        [[nodiscard]] const std::optional<SeekCondition>& seek_condition() const &
+        {
+            return seek_;
+        }
+
+        [[nodiscard]] const std::optional<RelevanceCondition>& relevance_condition() const &
+        {
+            return relevance_;
+        }
+
+        [[nodiscard]] bool pattern_ranking() const &
+        {
+            return rank_patterns_;
+        }
+
         [[nodiscard]] bool empty() const
         {
             return conditions_.empty() && patterns_.empty() && orders_.empty() && similarity_conditions_.empty() && !
-                pages_.has_value();
+                pages_.has_value() && !seek_.has_value() && !relevance_.has_value();
         }
 
     private:
@@ -360,5 +471,8 @@ namespace drug_lib::common::database
         std::vector<SimilarityCondition> similarity_conditions_;
         std::vector<OrderCondition> orders_;
         std::optional<PageCondition> pages_;
+        std::optional<SeekCondition> seek_;
+        std::optional<RelevanceCondition> relevance_;
+        bool rank_patterns_ = false;
     };
 }
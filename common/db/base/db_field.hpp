@@ -11,11 +11,32 @@
 #include <utility>
 #include <json/json.h>
 
+#include "db_record_arena.hpp"
+
 namespace drug_lib::common::database
 {
 	template <typename T>
 	class Field;
 
+	/// @brief JSON text without indentation and newlines, as sent to the database.
+	/// Writer and its buffer are reused by the thread
+	inline std::string to_compact_json(const Json::Value &value)
+	{
+		thread_local const std::unique_ptr<Json::StreamWriter> writer = []
+		{
+			Json::StreamWriterBuilder builder;
+			builder["indentation"] = "";
+			builder["commentStyle"] = "None";
+			builder["emitUTF8"] = true;
+			return std::unique_ptr<Json::StreamWriter>(builder.newStreamWriter());
+		}();
+		thread_local std::ostringstream buffer;
+		// Keeps the capacity of the buffer
+		buffer.str(std::string());
+		writer->write(value, &buffer);
+		return buffer.str();
+	}
+
 	/// @brief Base class representing a field in the database
 	enum class SqlType
 	{
@@ -67,6 +88,45 @@ namespace drug_lib::common::database
 			return uuid_;
 		}
 
+		/// @brief Id in the form Postgres returns it: lowercase, hyphenated. Uppercase, braced and unhyphenated
+		/// inputs are accepted as Postgres accepts them, any other string is returned unchanged
+		[[nodiscard]] std::string canonical_id() const
+		{
+			static constexpr std::size_t digits = 32;
+			std::string hex;
+			hex.reserve(digits);
+			const bool braced = uuid_.size() > 1 && uuid_.front() == '{' && uuid_.back() == '}';
+			for (std::size_t i = braced ? 1 : 0; i < uuid_.size() - (braced ? 1 : 0); ++i)
+			{
+				const char symbol = uuid_[i];
+				if (symbol == '-')
+				{
+					continue;
+				}
+				if (symbol >= 'A' && symbol <= 'F')
+				{
+					hex.push_back(static_cast<char>(symbol - 'A' + 'a'));
+				}
+				else if ((symbol >= '0' && symbol <= '9') || (symbol >= 'a' && symbol <= 'f'))
+				{
+					hex.push_back(symbol);
+				}
+				else
+				{
+					return uuid_;
+				}
+			}
+			if (hex.size() != digits)
+			{
+				return uuid_;
+			}
+			for (const std::size_t position: {8, 13, 18, 23})
+			{
+				hex.insert(position, 1, '-');
+			}
+			return hex;
+		}
+
 		void set_id(std::string uuid)
 		{
 			uuid_ = std::move(uuid);
@@ -181,6 +241,17 @@ namespace drug_lib::common::database
 	public:
 		virtual ~FieldBase() = default;
 
+		/// @brief Fields are allocated from the current RecordArena of the thread if there is one
+		static void *operator new(const std::size_t size)
+		{
+			return ArenaAllocation::allocate(size);
+		}
+
+		static void operator delete(void *ptr) noexcept
+		{
+			ArenaAllocation::deallocate(ptr);
+		}
+
 		/// @return Column name of the field
 		[[nodiscard]] virtual const std::string &get_name() const = 0;
 
@@ -280,7 +351,7 @@ namespace drug_lib::common::database
 			}
 			else if constexpr (std::is_same_v<T, Json::Value>)
 			{
-				return value_.toStyledString();
+				return to_compact_json(value_);
 			}
 			else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>)
 			{
@@ -319,7 +390,7 @@ namespace drug_lib::common::database
 			}
 			else if constexpr (std::is_same_v<T, Json::Value>)
 			{
-				return value_.toStyledString(); // Move the JSON string representation
+				return to_compact_json(value_);
 			}
 			else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>)
 			{
@@ -1,8 +1,11 @@
 // db_record.hpp
 
 #pragma once
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "db_field.hpp"
 
@@ -105,6 +108,39 @@ namespace drug_lib::common::database
     };
 
 
+    /// @brief Column names of a result set, shared by its rows. Lets readers resolve column ordinals once
+    /// per result instead of comparing names in every row
+    class ColumnMap final
+    {
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        explicit ColumnMap(std::vector<std::string> names)
+            : names_(std::move(names))
+        {
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return names_.size();
+        }
+
+        [[nodiscard]] const std::string& name(const std::size_t idx) const
+        {
+            return names_[idx];
+        }
+
+        /// @return Ordinal of the column, npos if there is no such column
+        [[nodiscard]] std::size_t find(const std::string_view name) const
+        {
+            const auto it = std::ranges::find(names_, name);
+            return it == names_.end() ? npos : static_cast<std::size_t>(it - names_.begin());
+        }
+
+    private:
+        std::vector<std::string> names_;
+    };
+
     class ViewRecord
     {
     public:
@@ -113,6 +149,18 @@ namespace drug_lib::common::database
         [[nodiscard]] virtual std::string extract(std::size_t idx) const & = 0;
         [[nodiscard]] virtual std::size_t size() const & = 0;
         [[nodiscard]] virtual std::string name(std::size_t idx) const & = 0;
+
+        /// @return Columns of the result set the row belongs to. Rows of one result return the same map
+        [[nodiscard]] virtual std::shared_ptr<const ColumnMap> columns() const &
+        {
+            std::vector<std::string> names;
+            names.reserve(size());
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                names.push_back(name(i));
+            }
+            return std::make_shared<const ColumnMap>(std::move(names));
+        }
     };
 
     class BaseViewRecord final : public ViewRecord
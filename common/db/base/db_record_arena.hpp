@@ -0,0 +1,117 @@
+// db_record_arena.hpp
+
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace drug_lib::common::database
+{
+    /// @brief Monotonic buffer for the fields of a request or a batch. While a scope of the arena is open,
+    /// fields created by the thread (to_record, select of the clients, clone) are carved from the arena,
+    /// deleting them is free and the memory is returned at once by reset or destruction.
+    /// @warning Records made in a scope must be destroyed before the arena is reset or destroyed.
+    /// Arena isn't thread safe, it is used by the thread which opened the scope
+    class RecordArena final
+    {
+    public:
+        /// @brief Makes the arena current for the thread until destruction, the previous one is restored after
+        class Scope final
+        {
+        public:
+            explicit Scope(RecordArena& arena)
+                : previous_(current_)
+            {
+                current_ = &arena;
+            }
+
+            ~Scope()
+            {
+                current_ = previous_;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            RecordArena* previous_;
+        };
+
+        /// @param initial_size Size of the first buffer, next ones grow geometrically
+        explicit RecordArena(const std::size_t initial_size = 1 << 16)
+            : resource_(initial_size)
+        {
+        }
+
+        RecordArena(const RecordArena&) = delete;
+        RecordArena& operator=(const RecordArena&) = delete;
+
+        /// @return Arena of the innermost open scope of the thread, nullptr if there is none
+        [[nodiscard]] static RecordArena* current()
+        {
+            return current_;
+        }
+
+        [[nodiscard]] void* allocate(const std::size_t size, const std::size_t alignment)
+        {
+            allocated_ += size;
+            return resource_.allocate(size, alignment);
+        }
+
+        /// @brief Release all memory of the arena at once
+        void reset()
+        {
+            resource_.release();
+            allocated_ = 0;
+        }
+
+        /// @return Bytes handed out since creation or the last reset
+        [[nodiscard]] std::size_t allocated() const
+        {
+            return allocated_;
+        }
+
+    private:
+        inline static thread_local RecordArena* current_ = nullptr;
+        std::pmr::monotonic_buffer_resource resource_;
+        std::size_t allocated_ = 0;
+    };
+
+    /// @brief Allocation of an object either from the current arena or from the heap.
+    /// Header before the object tells delete which one it was
+    struct ArenaAllocation
+    {
+        static constexpr std::size_t header_size = alignof(std::max_align_t);
+
+        static void* allocate(const std::size_t size)
+        {
+            std::byte* block;
+            bool from_arena = false;
+            if (RecordArena* arena = RecordArena::current())
+            {
+                block = static_cast<std::byte*>(arena->allocate(size + header_size, header_size));
+                from_arena = true;
+            }
+            else
+            {
+                block = static_cast<std::byte*>(::operator new(size + header_size));
+            }
+            *reinterpret_cast<bool*>(block) = from_arena;
+            return block + header_size;
+        }
+
+        static void deallocate(void* ptr) noexcept
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            std::byte* block = static_cast<std::byte*>(ptr) - header_size;
+            // Arena memory is released by the arena itself
+            if (!*reinterpret_cast<bool*>(block))
+            {
+                ::operator delete(block);
+            }
+        }
+    };
+}
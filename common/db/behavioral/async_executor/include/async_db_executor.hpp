@@ -0,0 +1,153 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace drug_lib::common::database::behavioral
+{
+    /// @brief Moves blocking database work off the caller thread (e.g. event loop of the server).
+    /// Work is queued and executed by a fixed number of workers, so any number of requests can wait for the database
+    /// without holding a thread. Workers count should match the size of the connection pool used by the work,
+    /// then a worker never waits for a connection
+    class AsyncDbExecutor
+    {
+    public:
+        /// @brief Schedules continuation of the awaiting coroutine, e.g. back to its event loop.
+        /// Empty resumer continues the coroutine on the worker thread
+        using Resumer = std::function<void(std::function<void()>)>;
+
+        /// @brief Awaitable result of the work, the coroutine is suspended until the work is done
+        template <typename T>
+        class Awaitable
+        {
+        public:
+            Awaitable(AsyncDbExecutor& executor, std::function<T()>&& work, Resumer&& resumer)
+                : executor_(executor), work_(std::move(work)), resumer_(std::move(resumer)),
+                  state_(std::make_shared<State>())
+            {
+            }
+
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                executor_.post([work = std::move(work_), resumer = std::move(resumer_), state = state_, handle]
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            work();
+                        }
+                        else
+                        {
+                            state->value.emplace(work());
+                        }
+                    }
+                    catch (...)
+                    {
+                        state->error = std::current_exception();
+                    }
+                    if (resumer)
+                    {
+                        resumer([handle] { handle.resume(); });
+                    }
+                    else
+                    {
+                        handle.resume();
+                    }
+                });
+            }
+
+            /// @throws Exception thrown by the work
+            T await_resume()
+            {
+                if (state_->error)
+                {
+                    std::rethrow_exception(state_->error);
+                }
+                if constexpr (!std::is_void_v<T>)
+                {
+                    return std::move(*state_->value);
+                }
+            }
+
+        private:
+            struct State
+            {
+                std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+                std::exception_ptr error;
+            };
+
+            AsyncDbExecutor& executor_;
+            std::function<T()> work_;
+            Resumer resumer_;
+            std::shared_ptr<State> state_;
+        };
+
+        /// @brief Run the work on a worker
+        /// @return Future of the work result, exception of the work is stored in the future
+        template <typename Func>
+            requires std::invocable<Func>
+        std::future<std::invoke_result_t<Func>> submit(Func&& work)
+        {
+            auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(work));
+            auto future = task->get_future();
+            post([task] { (*task)(); });
+            return future;
+        }
+
+        /// @brief Run the work on a worker and resume the awaiting coroutine with its result by the resumer
+        template <typename Func>
+            requires std::invocable<Func>
+        [[nodiscard]] Awaitable<std::invoke_result_t<Func>> run(Func&& work, Resumer resumer = {})
+        {
+            return {*this, std::function<std::invoke_result_t<Func>()>(std::forward<Func>(work)), std::move(resumer)};
+        }
+
+        /// @return Number of the queued work which is not started yet
+        [[nodiscard]] std::size_t pending() const;
+
+        [[nodiscard]] std::size_t workers() const
+        {
+            return workers_.size();
+        }
+
+        /// @throws std::invalid_argument If workers count is 0
+        explicit AsyncDbExecutor(std::size_t workers_count);
+
+        AsyncDbExecutor(const AsyncDbExecutor&) = delete;
+        AsyncDbExecutor& operator=(const AsyncDbExecutor&) = delete;
+
+        /// @brief Finishes the queued work and joins the workers
+        ~AsyncDbExecutor();
+
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable_any has_work_;
+        std::deque<std::function<void()>> queue_;
+        bool stopped_ = false;
+        std::vector<std::jthread> workers_;
+
+        /// @throws std::runtime_error If the executor is stopped
+        void post(std::function<void()>&& job);
+
+        void work_loop(const std::stop_token& stop_token);
+    };
+}
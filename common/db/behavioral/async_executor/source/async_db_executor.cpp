@@ -0,0 +1,84 @@
+#include "async_db_executor.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace drug_lib::common::database::behavioral
+{
+    AsyncDbExecutor::AsyncDbExecutor(const std::size_t workers_count)
+    {
+        if (workers_count == 0)
+        {
+            throw std::invalid_argument("Executor needs at least one worker.\t");
+        }
+        workers_.reserve(workers_count);
+        for (std::size_t i = 0; i < workers_count; ++i)
+        {
+            workers_.emplace_back([this](const std::stop_token& stop_token)
+            {
+                work_loop(stop_token);
+            });
+        }
+    }
+
+    AsyncDbExecutor::~AsyncDbExecutor()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopped_ = true;
+        }
+        for (auto& worker : workers_)
+        {
+            worker.request_stop();
+        }
+        has_work_.notify_all();
+        workers_.clear();
+    }
+
+    std::size_t AsyncDbExecutor::pending() const
+    {
+        std::lock_guard lock(mutex_);
+        return queue_.size();
+    }
+
+    void AsyncDbExecutor::post(std::function<void()>&& job)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (stopped_)
+            {
+                throw std::runtime_error("Executor is stopped.\t");
+            }
+            queue_.push_back(std::move(job));
+        }
+        has_work_.notify_one();
+    }
+
+    void AsyncDbExecutor::work_loop(const std::stop_token& stop_token)
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(mutex_);
+                // Queued work is finished even after the stop
+                has_work_.wait(lock, stop_token, [this] { return !queue_.empty(); });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            try
+            {
+                job();
+            }
+            catch (const std::exception& e)
+            {
+                // Results and errors are delivered by the job itself, this is a failure of the delivery
+                std::cerr << "Async database job failed: " << e.what() << std::endl;
+            }
+        }
+    }
+}
@@ -1 +1,341 @@
 #include "db_interface_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace drug_lib::common::database::creational
+{
+    using namespace exceptions;
+    using db_err = errors::db_error_code;
+
+    DbInterfacePool::DbInterfacePool(const PoolSettings& settings)
+        : settings_(settings)
+    {
+        if (settings_.max_size != 0 && settings_.min_size > settings_.max_size)
+        {
+            throw std::invalid_argument("Min size of the pool is greater than max size.\t");
+        }
+        if (settings_.health_check_interval.count() > 0)
+        {
+            health_checker_ = std::jthread([this](const std::stop_token& stop_token)
+            {
+                health_loop(stop_token);
+            });
+        }
+    }
+
+    DbInterfacePool::~DbInterfacePool()
+    {
+        if (health_checker_.joinable())
+        {
+            health_checker_.request_stop();
+            health_checker_.join();
+        }
+        {
+            std::lock_guard lock(mutex_);
+            closed_ = true;
+        }
+        available_.notify_all();
+        clear();
+    }
+
+    std::shared_ptr<interfaces::DbInterface> DbInterfacePool::acquire_db_interface()
+    {
+        return acquire_db_interface(settings_.acquire_timeout);
+    }
+
+    std::shared_ptr<interfaces::DbInterface> DbInterfacePool::acquire_db_interface(
+        const std::chrono::milliseconds timeout)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_lock lock(mutex_);
+        if (closed_)
+        {
+            throw ConnectionException("Pool is closed.\t", db_err::CONNECTION_FAILED);
+        }
+        if (idle_.empty() && can_grow())
+        {
+            // Reserve the slot and connect without blocking the others
+            ++total_;
+            ++in_use_;
+            lock.unlock();
+            std::shared_ptr<interfaces::DbInterface> obj;
+            try
+            {
+                obj = create_connection();
+            }
+            catch (...)
+            {
+                lock.lock();
+                --total_;
+                --in_use_;
+                throw;
+            }
+            lock.lock();
+            record_wait(std::chrono::steady_clock::now() - start);
+            return obj;
+        }
+        if (!available_.wait_for(lock, timeout, [this] { return !idle_.empty() || closed_; }) || closed_)
+        {
+            ++timeouts_;
+            throw ConnectionException("Pool is exhausted.\t", db_err::CONNECTION_POOL_EXHAUSTED);
+        }
+        auto obj = std::move(idle_.back());
+        idle_.pop_back();
+        ++in_use_;
+        record_wait(std::chrono::steady_clock::now() - start);
+        return obj;
+    }
+
+    DbInterfacePool::Lease DbInterfacePool::lease()
+    {
+        return {*this, acquire_db_interface()};
+    }
+
+    DbInterfacePool::Lease DbInterfacePool::lease(const std::chrono::milliseconds timeout)
+    {
+        return {*this, acquire_db_interface(timeout)};
+    }
+
+    void DbInterfacePool::release_db_interface(std::shared_ptr<interfaces::DbInterface>&& obj)
+    {
+        if (obj == nullptr)
+        {
+            throw std::invalid_argument("Invalid interface.\t");
+        }
+        {
+            std::lock_guard lock(mutex_);
+            if (in_use_ > 0)
+            {
+                --in_use_;
+            }
+            else
+            {
+                // Connection wasn't acquired from this pool
+                ++total_;
+            }
+            if (!closed_)
+            {
+                idle_.push_back(std::move(obj));
+                available_.notify_one();
+                return;
+            }
+            --total_;
+        }
+        obj->drop_connect();
+    }
+
+    void DbInterfacePool::check_health()
+    {
+        std::size_t unchecked;
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_)
+            {
+                return;
+            }
+            unchecked = idle_.size();
+        }
+        // One connection is taken at a time, the rest stay available to acquire meanwhile
+        for (; unchecked > 0; --unchecked)
+        {
+            std::shared_ptr<interfaces::DbInterface> connect;
+            {
+                std::lock_guard lock(mutex_);
+                if (closed_ || idle_.empty())
+                {
+                    break;
+                }
+                // Least recently returned one, acquire takes connections from the back
+                connect = std::move(idle_.front());
+                idle_.erase(idle_.begin());
+                ++in_use_;
+            }
+            if (connect->is_alive())
+            {
+                release_db_interface(std::move(connect));
+                continue;
+            }
+            try
+            {
+                connect = create_connection();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to replace dead connection: " << e.what() << std::endl;
+                std::lock_guard lock(mutex_);
+                --in_use_;
+                --total_;
+                continue;
+            }
+            {
+                std::lock_guard lock(mutex_);
+                ++replaced_;
+            }
+            release_db_interface(std::move(connect));
+        }
+        std::size_t missing = 0;
+        {
+            std::lock_guard lock(mutex_);
+            if (total_ < settings_.min_size && factory_)
+            {
+                missing = settings_.min_size - total_;
+                total_ += missing;
+                in_use_ += missing;
+            }
+        }
+        for (std::size_t i = 0; i < missing; ++i)
+        {
+            std::shared_ptr<interfaces::DbInterface> connect;
+            try
+            {
+                connect = create_connection();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to top up the pool: " << e.what() << std::endl;
+            }
+            std::lock_guard lock(mutex_);
+            --in_use_;
+            if (connect)
+            {
+                idle_.push_back(std::move(connect));
+                available_.notify_one();
+            }
+            else
+            {
+                --total_;
+            }
+        }
+    }
+
+    void DbInterfacePool::set_initializer(
+        std::function<void(const std::shared_ptr<interfaces::DbInterface>&)> initializer)
+    {
+        std::vector<std::shared_ptr<interfaces::DbInterface>> idle;
+        {
+            std::lock_guard lock(mutex_);
+            initializer_ = std::move(initializer);
+            idle.swap(idle_);
+            in_use_ += idle.size();
+        }
+        // Connections are returned even if the initializer fails, the error goes to the caller
+        std::exception_ptr error;
+        for (const auto& connect : idle)
+        {
+            try
+            {
+                initialize(connect);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+                break;
+            }
+        }
+        {
+            std::lock_guard lock(mutex_);
+            in_use_ -= idle.size();
+            for (auto& connect : idle)
+            {
+                idle_.push_back(std::move(connect));
+            }
+        }
+        available_.notify_all();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    PoolMetrics DbInterfacePool::metrics() const
+    {
+        std::lock_guard lock(mutex_);
+        PoolMetrics metrics;
+        metrics.total = total_;
+        metrics.idle = idle_.size();
+        metrics.in_use = in_use_;
+        metrics.acquisitions = acquisitions_;
+        metrics.timeouts = timeouts_;
+        metrics.replaced = replaced_;
+        metrics.total_wait = total_wait_;
+        metrics.max_wait = max_wait_;
+        return metrics;
+    }
+
+    void DbInterfacePool::clear()
+    {
+        std::vector<std::shared_ptr<interfaces::DbInterface>> dropped;
+        {
+            std::lock_guard lock(mutex_);
+            dropped.swap(idle_);
+            total_ -= dropped.size();
+        }
+        for (const auto& connect : dropped)
+        {
+            connect->drop_connect();
+        }
+        std::cout << "Destructed pool." << std::endl;
+    }
+
+    bool DbInterfacePool::can_grow() const
+    {
+        return factory_ && settings_.max_size != 0 && total_ < settings_.max_size;
+    }
+
+    std::shared_ptr<interfaces::DbInterface> DbInterfacePool::create_connection() const
+    {
+        std::shared_ptr<interfaces::DbInterface> connect = factory_();
+        if (connect == nullptr)
+        {
+            throw std::runtime_error("Factory function failed to create a valid DbInterface instance.\t");
+        }
+        initialize(connect);
+        return connect;
+    }
+
+    void DbInterfacePool::initialize(const std::shared_ptr<interfaces::DbInterface>& connect) const
+    {
+        std::function<void(const std::shared_ptr<interfaces::DbInterface>&)> initializer;
+        {
+            std::lock_guard lock(mutex_);
+            initializer = initializer_;
+        }
+        if (initializer)
+        {
+            initializer(connect);
+        }
+    }
+
+    void DbInterfacePool::record_wait(const std::chrono::steady_clock::duration wait)
+    {
+        const auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(wait);
+        ++acquisitions_;
+        total_wait_ += wait_us;
+        max_wait_ = std::max(max_wait_, wait_us);
+    }
+
+    void DbInterfacePool::health_loop(const std::stop_token& stop_token)
+    {
+        while (!stop_token.stop_requested())
+        {
+            {
+                std::unique_lock lock(mutex_);
+                health_wakeup_.wait_for(lock, stop_token, settings_.health_check_interval,
+                                        [&stop_token] { return stop_token.stop_requested(); });
+            }
+            if (stop_token.stop_requested())
+            {
+                return;
+            }
+            try
+            {
+                check_health();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Pool health check failed: " << e.what() << std::endl;
+            }
+        }
+    }
+}
@@ -1,72 +1,232 @@
 #pragma once
 
-#include <memory>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "db_interface.hpp"
+#include "exceptions.hpp"
 
 namespace drug_lib::common::database::creational
 {
+    /// @brief Sizing and timing of the pool
+    struct PoolSettings
+    {
+        /// Health checks top the pool up to this size
+        std::size_t min_size = 0;
+        /// Upper bound of connections, 0 - only filled connections are used
+        std::size_t max_size = 0;
+        /// How long acquire waits for a free connection before throwing
+        std::chrono::milliseconds acquire_timeout{1000};
+        /// Period of background liveness checks of idle connections, 0 - disabled
+        std::chrono::milliseconds health_check_interval{0};
+    };
+
+    /// @brief Snapshot of the pool counters
+    struct PoolMetrics
+    {
+        std::size_t total = 0;
+        std::size_t idle = 0;
+        std::size_t in_use = 0;
+        uint64_t acquisitions = 0;
+        uint64_t timeouts = 0;
+        uint64_t replaced = 0;
+        std::chrono::microseconds total_wait{0};
+        std::chrono::microseconds max_wait{0};
+
+        /// @return Part of the connections in use, 0 - 1
+        [[nodiscard]] double utilisation() const
+        {
+            return total == 0 ? 0.0 : static_cast<double>(in_use) / static_cast<double>(total);
+        }
+
+        [[nodiscard]] std::chrono::microseconds average_wait() const
+        {
+            return acquisitions == 0
+                       ? std::chrono::microseconds{0}
+                       : total_wait / static_cast<int64_t>(acquisitions);
+        }
+    };
+
     class DbInterfacePool
     {
     public:
-        std::shared_ptr<interfaces::DbInterface> acquire_db_interface()
+        /// @brief Connection borrowed from the pool, returned back on scope exit
+        class Lease
         {
-            if (!pool_.empty())
+        public:
+            Lease() = default;
+
+            Lease(DbInterfacePool& pool, std::shared_ptr<interfaces::DbInterface>&& connect)
+                : pool_(&pool), connect_(std::move(connect))
             {
-                auto obj = std::move(pool_.top());
-                pool_.pop();
-                return obj;
             }
-            throw std::runtime_error("Pool is exhausted.\t");
-        }
 
-        void release_db_interface(std::shared_ptr<interfaces::DbInterface>&& obj)
-        {
-            if (obj == nullptr)
+            Lease(Lease&& other) noexcept
+                : pool_(std::exchange(other.pool_, nullptr)), connect_(std::move(other.connect_))
             {
-                throw std::invalid_argument("Invalid interface.\t");
             }
-            pool_.push(std::move(obj));
-        }
 
-        // Fills the pool with a specified number of instances, created by the provided factory function
+            Lease& operator=(Lease&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    pool_ = std::exchange(other.pool_, nullptr);
+                    connect_ = std::move(other.connect_);
+                }
+                return *this;
+            }
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            ~Lease()
+            {
+                reset();
+            }
+
+            /// @brief Return the connection to the pool before the scope exit
+            void reset()
+            {
+                if (pool_ != nullptr && connect_ != nullptr)
+                {
+                    pool_->release_db_interface(std::move(connect_));
+                }
+                pool_ = nullptr;
+                connect_.reset();
+            }
+
+            [[nodiscard]] const std::shared_ptr<interfaces::DbInterface>& get() const
+            {
+                return connect_;
+            }
+
+            interfaces::DbInterface* operator->() const
+            {
+                return connect_.get();
+            }
+
+            interfaces::DbInterface& operator*() const
+            {
+                return *connect_;
+            }
+
+            explicit operator bool() const
+            {
+                return connect_ != nullptr;
+            }
+
+        private:
+            DbInterfacePool* pool_ = nullptr;
+            std::shared_ptr<interfaces::DbInterface> connect_;
+        };
+
+        /// @brief Borrow a connection, waiting for a free one up to acquire_timeout.
+        /// Creates a new connection if the pool is below max_size
+        /// @throws drug_lib::common::database::exceptions::ConnectionException If no connection became free in time
+        std::shared_ptr<interfaces::DbInterface> acquire_db_interface();
+
+        std::shared_ptr<interfaces::DbInterface> acquire_db_interface(std::chrono::milliseconds timeout);
+
+        /// @brief Borrow a connection which is returned automatically by the lease
+        /// @warning The pool must outlive its leases
+        [[nodiscard]] Lease lease();
+
+        [[nodiscard]] Lease lease(std::chrono::milliseconds timeout);
+
+        void release_db_interface(std::shared_ptr<interfaces::DbInterface>&& obj);
+
+        // Fills the pool with a specified number of instances, created by the provided factory function.
+        // The factory is kept for growing the pool and replacing dead connections
         template <typename FactoryFunc, typename... Args>
             requires std::invocable<FactoryFunc, Args...> &&
             std::same_as<std::invoke_result_t<FactoryFunc, Args...>, std::unique_ptr<interfaces::DbInterface>> ||
             std::same_as<std::invoke_result_t<FactoryFunc, Args...>, std::shared_ptr<interfaces::DbInterface>>
         void fill(const std::size_t size, FactoryFunc&& factory, Args&&... args)
         {
+            {
+                std::lock_guard lock(mutex_);
+                factory_ = [factory, ... args = args]() -> std::shared_ptr<interfaces::DbInterface>
+                {
+                    return factory(args...);
+                };
+            }
             for (std::size_t i = 0; i < size; ++i)
             {
                 if (std::shared_ptr<interfaces::DbInterface> db_interface = factory(std::forward<Args>(args)...))
                 {
-                    pool_.push(std::move(db_interface));
+                    initialize(db_interface);
+                    std::lock_guard lock(mutex_);
+                    idle_.push_back(std::move(db_interface));
+                    ++total_;
                 }
                 else
                 {
                     throw std::runtime_error("Factory function failed to create a valid DbInterface instance.\t");
                 }
             }
+            available_.notify_all();
         }
 
-        void clear()
-        {
-            while (!pool_.empty())
-            {
-                pool_.top()->drop_connect();
-                pool_.pop();
-            }
-            std::cout << "Destructed pool." << std::endl;
-        }
+        /// @brief Set up every connection of the pool with the initializer: current idle ones and all created later
+        /// (filled, grown or replacing dead ones). Should be set before serving
+        void set_initializer(std::function<void(const std::shared_ptr<interfaces::DbInterface>&)> initializer);
+
+        /// @brief Check idle connections once: dead ones are replaced by new ones, pool is topped up to min_size.
+        /// Connections are checked one by one, the others can be acquired meanwhile
+        void check_health();
+
+        [[nodiscard]] PoolMetrics metrics() const;
+
+        /// @brief Drop idle connections. Connections in use are dropped when they are returned
+        void clear();
 
         DbInterfacePool() = default;
 
-        ~DbInterfacePool()
-        {
-            clear();
-        }
+        explicit DbInterfacePool(const PoolSettings& settings);
+
+        DbInterfacePool(const DbInterfacePool&) = delete;
+        DbInterfacePool& operator=(const DbInterfacePool&) = delete;
+
+        ~DbInterfacePool();
 
     private:
-        std::stack<std::shared_ptr<interfaces::DbInterface>> pool_;
+        PoolSettings settings_;
+        std::function<std::shared_ptr<interfaces::DbInterface>()> factory_;
+        std::function<void(const std::shared_ptr<interfaces::DbInterface>&)> initializer_;
+        mutable std::mutex mutex_;
+        std::condition_variable available_;
+        std::vector<std::shared_ptr<interfaces::DbInterface>> idle_;
+        std::size_t total_ = 0;
+        std::size_t in_use_ = 0;
+        bool closed_ = false;
+
+        uint64_t acquisitions_ = 0;
+        uint64_t timeouts_ = 0;
+        uint64_t replaced_ = 0;
+        std::chrono::microseconds total_wait_{0};
+        std::chrono::microseconds max_wait_{0};
+
+        std::condition_variable_any health_wakeup_;
+        std::jthread health_checker_;
+
+        [[nodiscard]] bool can_grow() const;
+
+        std::shared_ptr<interfaces::DbInterface> create_connection() const;
+
+        void initialize(const std::shared_ptr<interfaces::DbInterface>& connect) const;
+
+        void record_wait(std::chrono::steady_clock::duration wait);
+
+        void health_loop(const std::stop_token& stop_token);
     };
 }
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <vector>
 
+#include "db_columnar.hpp"
 #include "db_conditions.hpp"
 #include "db_field.hpp"
 #include "db_record.hpp"
+#include "db_row_cursor.hpp"
 
 namespace drug_lib::common::database::interfaces
 {
@@ -17,6 +21,13 @@ namespace drug_lib::common::database::interfaces
 	template <typename T>
 	concept FieldBaseVector = std::is_same_v<std::remove_cvref_t<T>, std::vector<std::unique_ptr<FieldBase>>>;
 
+	/// @brief One read of a batch: rows of the table following conditions. Empty conditions select all rows
+	struct ViewQuery
+	{
+		std::string table_name;
+		Conditions conditions;
+	};
+
 	class DbInterface
 	{
 	public:
@@ -31,6 +42,13 @@ namespace drug_lib::common::database::interfaces
 
 		virtual void drop_connect() = 0;
 
+		/// @brief Liveness check of the underlying connection
+		[[nodiscard]] virtual bool is_alive() const = 0;
+
+		/// @brief Statements of this connection running longer are cancelled by the backend.
+		/// Zero restores the default of the backend
+		virtual void set_statement_timeout(std::chrono::milliseconds timeout) = 0;
+
 		// Table Management
 		virtual void create_table(std::string_view table_name, const Record &field_list) = 0;
 
@@ -89,6 +107,15 @@ namespace drug_lib::common::database::interfaces
 			                                            returning_fields);
 		}
 
+		/// @brief Stream rows into the table bypassing the query building(COPY in SQL backends).
+		/// Column list is taken from the first record, all records must have the same layout.
+		/// Records conflicting with the existing ones are skipped
+		template <RecordContainer Rows>
+		void bulk_load(std::string_view table_name, Rows &&rows)
+		{
+			bulk_load_implementation(table_name, std::forward<Rows>(rows));
+		}
+
 		// Data Retrieval
 		[[nodiscard]] virtual std::vector<Record> select(
 			std::string_view table_name) const = 0;
@@ -104,6 +131,29 @@ namespace drug_lib::common::database::interfaces
 
 		[[nodiscard]] virtual std::vector<std::unique_ptr<ViewRecord>> view(std::string_view table_name) const = 0;
 
+		/// @brief Several reads sent to the backend together, so they cost about one round-trip
+		/// @return Rows of each query in the order of queries
+		[[nodiscard]] virtual std::vector<std::vector<std::unique_ptr<ViewRecord>>> view_batch(
+			const std::vector<ViewQuery> &queries) const = 0;
+
+		/// @brief Iterate over rows following conditions without materializing the whole result.
+		/// Empty conditions select all rows
+		/// @param batch_size Count of rows fetched from the backend at once
+		[[nodiscard]] virtual std::unique_ptr<RowCursor> stream(
+			std::string_view table_name,
+			const Conditions &conditions,
+			uint32_t batch_size) const = 0;
+
+		[[nodiscard]] virtual std::unique_ptr<RowCursor> stream(std::string_view table_name,
+		                                                        uint32_t batch_size) const = 0;
+
+		/// @brief Select rows following conditions into typed columns, for bulk reads scanning many rows.
+		/// Empty conditions select all rows
+		[[nodiscard]] virtual ColumnarResult select_columns(std::string_view table_name,
+		                                                    const Conditions &conditions) const = 0;
+
+		[[nodiscard]] virtual ColumnarResult select_columns(std::string_view table_name) const = 0;
+
 		// Remove Data
 		virtual void remove(
 			std::string_view table_name,
@@ -116,6 +166,9 @@ namespace drug_lib::common::database::interfaces
 
 		[[nodiscard]] virtual uint32_t count(std::string_view table_name) const = 0;
 
+		/// @brief Count of all rows from the table statistics, may lag behind the latest changes
+		[[nodiscard]] virtual uint32_t estimate_count(std::string_view table_name) const = 0;
+
 		virtual void set_search_fields(std::string_view table_name,
 		                               std::vector<std::shared_ptr<FieldBase>> fields) = 0;
 
@@ -128,6 +181,10 @@ namespace drug_lib::common::database::interfaces
 
 		virtual void insert_implementation(std::string_view table_name, std::vector<Record> &&rows) = 0;
 
+		virtual void bulk_load_implementation(std::string_view table_name, const std::vector<Record> &rows) = 0;
+
+		virtual void bulk_load_implementation(std::string_view table_name, std::vector<Record> &&rows) = 0;
+
 		[[nodiscard]] virtual std::vector<Record>
 		insert_with_returning_implementation(std::string_view table_name,
 		                                     const std::vector<Record> &rows,
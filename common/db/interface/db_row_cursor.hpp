@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "db_record.hpp"
+
+namespace drug_lib::common::database::interfaces
+{
+	/// @brief Pull based cursor over query result. Rows are fetched from the backend in batches,
+	/// so memory doesn't depend on result size
+	class RowCursor
+	{
+	public:
+		virtual ~RowCursor() = default;
+
+		/// @return Next row, converted to owning fields. Empty when the result is exhausted
+		[[nodiscard]] virtual std::optional<Record> next() = 0;
+
+		/// @return Next row without converting fields. Nullptr when the result is exhausted
+		[[nodiscard]] virtual std::unique_ptr<ViewRecord> next_view() = 0;
+
+		/// @return True if no more rows will be returned
+		[[nodiscard]] virtual bool exhausted() const = 0;
+
+		/// @brief Stop iterating and release backend resources. Called by destructor
+		virtual void close() = 0;
+	};
+}
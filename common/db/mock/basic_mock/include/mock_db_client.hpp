@@ -1,17 +1,61 @@
 // pqxx_client.hpp
 #pragma once
 
+#include <atomic>
 #include <db_interface.hpp>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <valarray>
 #include <vector>
 
 
 namespace drug_lib::common::database
 {
+    /// @brief Cursor over rows copied at creation, conditions are ignored like in the other mock queries
+    class MockRowCursor final : public interfaces::RowCursor
+    {
+    public:
+        explicit MockRowCursor(std::vector<Record>&& rows)
+            : rows_(std::move(rows))
+        {
+        }
+
+        [[nodiscard]] std::optional<Record> next() override
+        {
+            if (exhausted())
+            {
+                return std::nullopt;
+            }
+            return std::move(rows_[position_++]);
+        }
+
+        [[nodiscard]] std::unique_ptr<ViewRecord> next_view() override
+        {
+            std::cout << "next_view" << std::endl;
+            return nullptr;
+        }
+
+        [[nodiscard]] bool exhausted() const override
+        {
+            return position_ >= rows_.size();
+        }
+
+        void close() override
+        {
+            position_ = rows_.size();
+        }
+
+    private:
+        std::vector<Record> rows_;
+        std::size_t position_ = 0;
+    };
+
     class MockDbClient final : public interfaces::DbInterface
     {
     public:
@@ -30,6 +74,24 @@ namespace drug_lib::common::database
         void drop_connect() override
         {
             std::cout << "drop_connect " << std::endl;
+            alive_ = false;
+        }
+
+        [[nodiscard]] bool is_alive() const override
+        {
+            std::this_thread::sleep_for(alive_delay_);
+            return alive_;
+        }
+
+        /// @brief Make is_alive as slow as a round-trip to a loaded server
+        void set_alive_delay(const std::chrono::milliseconds delay)
+        {
+            alive_delay_ = delay;
+        }
+
+        void set_statement_timeout(std::chrono::milliseconds timeout) override
+        {
+            std::cout << "set_statement_timeout " << timeout.count() << std::endl;
         }
 
 
@@ -119,11 +181,15 @@ namespace drug_lib::common::database
         void remove_table(std::string_view table_name) override
         {
             std::cout << "remove_table " << std::endl;
+            std::lock_guard lock(storage_mutex_);
+            storage_.erase(std::string(table_name));
         }
 
         void truncate_table(std::string_view table_name) override
         {
             std::cout << "truncate_table " << std::endl;
+            std::lock_guard lock(storage_mutex_);
+            storage_.erase(std::string(table_name));
         }
 
         /// @return Existence status of table
@@ -151,7 +217,25 @@ namespace drug_lib::common::database
             std::string_view table_name) const override
         {
             std::cout << "select" << std::endl;
-            return {};
+            std::lock_guard lock(storage_mutex_);
+            const auto it = storage_.find(std::string(table_name));
+            if (it == storage_.end())
+            {
+                return {};
+            }
+            std::vector<Record> result;
+            result.reserve(it->second.size());
+            for (const auto& stored : it->second)
+            {
+                Record record;
+                record.reserve(stored.size());
+                for (const auto& field : stored)
+                {
+                    record.push_back(field->clone());
+                }
+                result.push_back(std::move(record));
+            }
+            return result;
         }
 
         /// @brief Faster than select, but doesn't transform and allows only one operation view field
@@ -174,6 +258,60 @@ namespace drug_lib::common::database
             return {};
         }
 
+        [[nodiscard]] std::vector<std::vector<std::unique_ptr<ViewRecord>>> view_batch(
+            const std::vector<interfaces::ViewQuery>& queries) const override
+        {
+            std::cout << "view_batch" << std::endl;
+            std::vector<std::vector<std::unique_ptr<ViewRecord>>> results;
+            results.reserve(queries.size());
+            for (const auto& [table_name, conditions] : queries)
+            {
+                results.push_back(conditions.empty() ? view(table_name) : view(table_name, conditions));
+            }
+            return results;
+        }
+
+        [[nodiscard]] std::unique_ptr<interfaces::RowCursor> stream(
+            std::string_view table_name,
+            const Conditions& conditions,
+            uint32_t batch_size) const override
+        {
+            std::cout << "stream" << std::endl;
+            return std::make_unique<MockRowCursor>(select(table_name));
+        }
+
+        [[nodiscard]] std::unique_ptr<interfaces::RowCursor> stream(std::string_view table_name,
+                                                                    uint32_t batch_size) const override
+        {
+            std::cout << "stream" << std::endl;
+            return std::make_unique<MockRowCursor>(select(table_name));
+        }
+
+        /// @brief Columns of the stored rows, conditions are ignored like in the other mock queries
+        [[nodiscard]] ColumnarResult select_columns(std::string_view table_name,
+                                                    const Conditions& conditions) const override
+        {
+            std::cout << "select_columns" << std::endl;
+            return select_columns(table_name);
+        }
+
+        [[nodiscard]] ColumnarResult select_columns(std::string_view table_name) const override
+        {
+            std::cout << "select_columns" << std::endl;
+            ColumnarResult result;
+            std::lock_guard lock(storage_mutex_);
+            const auto it = storage_.find(std::string(table_name));
+            if (it == storage_.end())
+            {
+                return result;
+            }
+            for (const auto& record : it->second)
+            {
+                result.append_record(record);
+            }
+            return result;
+        }
+
         // Remove Data
         ///@brief remove data following conditions
         void remove(std::string_view table_name,
@@ -195,7 +333,14 @@ namespace drug_lib::common::database
         [[nodiscard]] uint32_t count(std::string_view table_name) const override
         {
             std::cout << "count" << std::endl;
-            return 0;
+            std::lock_guard lock(storage_mutex_);
+            const auto it = storage_.find(std::string(table_name));
+            return it == storage_.end() ? 0 : static_cast<uint32_t>(it->second.size());
+        }
+
+        [[nodiscard]] uint32_t estimate_count(std::string_view table_name) const override
+        {
+            return count(table_name);
         }
 
         void set_search_fields(std::string_view table_name, std::vector<std::shared_ptr<FieldBase>> fields) override
@@ -254,6 +399,34 @@ namespace drug_lib::common::database
             std::cout << "insert_implementation " << std::endl;
         }
 
+        /// @brief Keeps loaded rows in memory, they are visible to select(table) and count(table)
+        void bulk_load_implementation(std::string_view table_name, const std::vector<Record>& rows) override
+        {
+            std::cout << "bulk_load_implementation " << std::endl;
+            std::vector<Record> copied;
+            copied.reserve(rows.size());
+            for (const auto& row : rows)
+            {
+                Record record;
+                record.reserve(row.size());
+                for (const auto& field : row)
+                {
+                    record.push_back(field->clone());
+                }
+                copied.push_back(std::move(record));
+            }
+            bulk_load_implementation(table_name, std::move(copied));
+        }
+
+        void bulk_load_implementation(std::string_view table_name, std::vector<Record>&& rows) override
+        {
+            std::cout << "bulk_load_implementation " << std::endl;
+            std::lock_guard lock(storage_mutex_);
+            auto& table = storage_[std::string(table_name)];
+            table.reserve(table.size() + rows.size());
+            std::move(rows.begin(), rows.end(), std::back_inserter(table));
+        }
+
         void upsert_implementation(std::string_view table_name,
                                    const std::vector<Record>& rows,
                                    const std::vector<std::shared_ptr<FieldBase>>& replace_fields) override
@@ -267,5 +440,11 @@ namespace drug_lib::common::database
         {
             std::cout << "upsert_implementation " << std::endl;
         }
+
+    private:
+        std::atomic<bool> alive_ = true;
+        std::chrono::milliseconds alive_delay_{0};
+        mutable std::mutex storage_mutex_;
+        std::unordered_map<std::string, std::vector<Record>> storage_;
     };
 }
@@ -1,8 +1,10 @@
 // pqxx_client.hpp
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <regex>
 #include <string>
 #include <string_view>
@@ -13,6 +15,8 @@
 #include "db_interface.hpp"
 #include "exceptions.hpp"
 #include "pqxx_connect_params.hpp"
+#include "pqxx_query_params.hpp"
+#include "pqxx_row_cursor.hpp"
 
 
 namespace drug_lib::common::database
@@ -20,6 +24,24 @@ namespace drug_lib::common::database
 	class PqxxClient final : public interfaces::DbInterface
 	{
 	public:
+		/// @brief Snapshot of the prepared statements registry counters
+		struct PreparedStatementsStats
+		{
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			std::size_t size = 0;
+		};
+
+		/// @brief Generated column with full text search document of the table
+		static constexpr std::string_view search_vector_column = "search_vector";
+
+		/// @brief Trailing columns of the rows selected with relevance condition
+		static constexpr std::string_view relevance_column = "relevance";
+		static constexpr std::string_view exact_match_column = "exact_match";
+
+		/// @brief Trailing column of the ranked seek pages, rank of the last row goes to the next seek condition
+		static constexpr std::string_view seek_rank_column = "seek_rank";
+
 		/// @brief Creating a database with given params using template db
 		static void create_database(std::string_view host,
 		                            uint32_t port,
@@ -32,6 +54,12 @@ namespace drug_lib::common::database
 		/// @brief Explicitly close the connection. Destructor does the same, but this function can throw exception
 		void drop_connect() override;
 
+		/// @return False if the connection is closed or doesn't answer a trivial query
+		[[nodiscard]] bool is_alive() const override;
+
+		/// @brief Sets statement_timeout of the session, inside a transaction it is reverted by rollback
+		void set_statement_timeout(std::chrono::milliseconds timeout) override;
+
 
 		/// @brief Trying to connect to the database, if connection isn't open will throw exception
 		/// @throws drug_lib::common::database::exceptions::ConnectionException
@@ -64,7 +92,8 @@ namespace drug_lib::common::database
 		void make_unique_constraint(std::string_view table_name,
 		                            std::vector<std::shared_ptr<FieldBase>> conflict_fields) override;
 
-		/// @brief Create full test search index for given fields
+		/// @brief Create full test search index for given fields. Document of the fields is stored in
+		/// search_vector column generated by the database, so searching doesn't recompute it per row
 		/// @param table_name For which table created index.
 		/// @param fields Fts fields
 		void setup_search_index(
@@ -75,7 +104,8 @@ namespace drug_lib::common::database
 		/// Allows restoring it(reindex) using restore_full_text_search method
 		void drop_search_index(std::string_view table_name) const override;
 
-		/// @brief Drop index + remove fields from this client. For using fts further setup_fulltext_search should be called again
+		/// @brief Drop index + search vector column + remove fields from this client.
+		/// For using fts further setup_fulltext_search should be called again
 		void remove_search_index(std::string_view table_name) override;
 
 		/// @brief Restore index + reindex. Use previous declared fts fields
@@ -119,6 +149,28 @@ namespace drug_lib::common::database
 		/// @warning If u needn't only view data, use select.
 		[[nodiscard]] std::vector<std::unique_ptr<ViewRecord>> view(std::string_view table_name) const override;
 
+		/// @brief Queries go out through pqxx::pipeline in one flush and are read back together.
+		/// Pipeline doesn't take parameters, so they are inlined as quoted literals,
+		/// cached queries are run as EXECUTE of their prepared statement
+		[[nodiscard]] std::vector<std::vector<std::unique_ptr<ViewRecord>>> view_batch(
+			const std::vector<interfaces::ViewQuery> &queries) const override;
+
+		/// @brief Server side cursor over the rows following conditions. Empty conditions select all rows
+		/// @warning Connection is busy until the cursor is exhausted or closed, see PqxxRowCursor
+		[[nodiscard]] std::unique_ptr<interfaces::RowCursor> stream(
+			std::string_view table_name,
+			const Conditions &conditions,
+			uint32_t batch_size) const override;
+
+		[[nodiscard]] std::unique_ptr<interfaces::RowCursor> stream(std::string_view table_name,
+		                                                            uint32_t batch_size) const override;
+
+		/// @brief Cells are decoded from the result text straight into the columns, no field objects are made
+		[[nodiscard]] ColumnarResult select_columns(std::string_view table_name,
+		                                            const Conditions &conditions) const override;
+
+		[[nodiscard]] ColumnarResult select_columns(std::string_view table_name) const override;
+
 		// Remove Data
 		///@brief remove data following conditions
 		void remove(std::string_view table_name,
@@ -132,16 +184,45 @@ namespace drug_lib::common::database
 		/// @return Count of all records in table
 		[[nodiscard]] uint32_t count(std::string_view table_name) const override;
 
+		/// @return Rows per page of the last analyze times the current pages of the table, exact count if the
+		/// table has not been analyzed yet
+		[[nodiscard]] uint32_t estimate_count(std::string_view table_name) const override;
+
+		/// @brief Declare fts fields of the existing table. Table indexed without stored search vector is migrated to it
 		void set_search_fields(std::string_view table_name, std::vector<std::shared_ptr<FieldBase>> fields) override;
 
 		void set_conflict_fields(std::string_view table_name, std::vector<std::shared_ptr<FieldBase>> fields) override;
 
+		/// @return Hit/miss counters of the prepared statements registry of this connection
+		[[nodiscard]] PreparedStatementsStats get_prepared_statements_stats() const;
+
+		/// @brief Deallocate all prepared statements of this connection and reset the registry.
+		/// Other clients of the process drop their statements before the next query, the schema may have changed
+		void reset_prepared_statements() const;
+
+		/// @brief Send jsonb values of inserts and upserts in the binary format: version byte and compact text.
+		/// Server doesn't need to convert the parameter from text and no quoting is needed
+		void set_binary_jsonb(const bool binary_jsonb)
+		{
+			binary_jsonb_ = binary_jsonb;
+		}
+
+		[[nodiscard]] bool is_binary_jsonb() const
+		{
+			return binary_jsonb_;
+		}
+
 	protected:
 		// Implementation Methods for Data Manipulation
 		void insert_implementation(std::string_view table_name, const std::vector<Record> &rows) override;
 
 		void insert_implementation(std::string_view table_name, std::vector<Record> &&rows) override;
 
+		/// @brief COPY FROM STDIN of the given rows. Default uuid columns are left to the table defaults
+		void bulk_load_implementation(std::string_view table_name, const std::vector<Record> &rows) override;
+
+		void bulk_load_implementation(std::string_view table_name, std::vector<Record> &&rows) override;
+
 		void upsert_implementation(std::string_view table_name,
 		                           const std::vector<Record> &rows,
 		                           const std::vector<std::shared_ptr<FieldBase>> &replace_fields) override;
@@ -175,18 +256,60 @@ namespace drug_lib::common::database
 		                                                         returning_fields) override;
 
 	private:
-		boost::container::flat_map<uint32_t, std::string> type_oids_; // id, name
+		friend class PqxxRowCursor;
+
+		struct TypeDecoder
+		{
+			std::unique_ptr<FieldBase> (*decode)(const pqxx::field &);
+			SqlType sql_type;
+		};
+
+		// oid, decoder. Filled once by the constructor and only read after, so decoding takes no lock
+		boost::container::flat_map<uint32_t, TypeDecoder> decoders_;
 		boost::container::flat_map<std::string, std::vector<std::shared_ptr<FieldBase>>> conflict_fields_ = {};
 		boost::container::flat_map<std::string, std::vector<std::shared_ptr<FieldBase>>> search_fields_ = {};
+		// Tables with stored search vector, columns selected from them instead of *
+		mutable boost::container::flat_map<std::string, std::string> select_lists_ = {};
 		std::shared_ptr<pqxx::connection> conn_;
 		mutable std::recursive_mutex conn_mutex_;
 		mutable std::unique_ptr<pqxx::work> open_transaction_;
 		bool in_transaction_;
-
+		bool binary_jsonb_ = false;
+
+		/// Statements longer than this (wide batch inserts) are executed without preparing
+		static constexpr std::size_t prepared_statement_max_length_ = 1 << 13;
+		static constexpr std::size_t prepared_statements_capacity_ = 1 << 9;
+		// hash of query shape(table + conditions + batch width), query text
+		mutable boost::container::flat_map<std::size_t, std::string> prepared_statements_;
+		mutable std::atomic<uint64_t> prepared_hits_{0};
+		mutable std::atomic<uint64_t> prepared_misses_{0};
+		// Bumped by the schema changes of any client, statements prepared before are stale
+		inline static std::atomic<uint64_t> schema_epoch_{0};
+		mutable uint64_t prepared_epoch_ = 0;
+
+		/// @brief Build the decoders table for the type oids of the connected database
 		void oid_preprocess();
 
+		/// @return Name of the prepared statement for the query, prepares it on the first call.
+		/// Empty if the query shouldn't be cached
+		[[nodiscard]] std::optional<std::string> acquire_prepared_statement(const std::string &query_string) const;
+
+		[[nodiscard]] static std::string make_prepared_statement_name(std::size_t query_hash);
+
+		void drop_prepared_statements() const;
+
+		pqxx::result execute_cached(pqxx::work &txn, const std::string &query_string,
+		                            const pqxx::params &params) const;
+
+		/// @return Parameterless statement equal to the query with the params, for pipelines
+		[[nodiscard]] std::string inline_params(const std::string &query_string, const PqxxQueryParams &params) const;
+
+		/// @throws std::invalid_argument If the field type has no decoder
 		[[nodiscard]] std::unique_ptr<FieldBase> process_field(const pqxx::field &field) const;
 
+		/// @throws std::invalid_argument If a column type has no decoder
+		[[nodiscard]] ColumnarResult process_columns(const pqxx::result &result) const;
+
 		// Utility Methods
 		[[nodiscard]] static bool is_valid_identifier(std::string_view identifier);
 
@@ -241,8 +364,7 @@ namespace drug_lib::common::database
 					else
 					{
 						query += "$" + std::to_string(param_counter++) + ", ";
-						// Call the correct version of to_string() depending on the value category
-						params.append(std::forward<decltype(field)>(field)->to_string());
+						append_param(params, *field);
 					}
 				}
 				query.erase(query.size() - 2); // Remove last comma and space
@@ -252,6 +374,114 @@ namespace drug_lib::common::database
 			return {query, params};
 		}
 
+		template <interfaces::RecordContainer Rec>
+		void stream_records(const std::string_view table_name, Rec &&rows) const
+		{
+			if (rows.empty())
+			{
+				throw exceptions::QueryException("No data provided for bulk load.",
+				                                 errors::db_error_code::INVALID_QUERY);
+			}
+			// COPY has no DEFAULT keyword, so default generated columns are omitted. The column is default in every
+			// row or in none of them, checked for each row below
+			const auto &first_record = rows.front();
+			std::vector<std::size_t> copied_columns;
+			std::vector<std::size_t> generated_columns;
+			copied_columns.reserve(first_record.size());
+			std::string columns;
+			for (std::size_t idx = 0; idx < first_record.size(); ++idx)
+			{
+				if (is_default_uuid(first_record[idx]))
+				{
+					generated_columns.push_back(idx);
+					continue;
+				}
+				copied_columns.push_back(idx);
+				columns.append(escape_identifier(first_record[idx]->get_name())).append(", ");
+			}
+			if (copied_columns.empty())
+			{
+				throw exceptions::QueryException("Nothing to copy, all columns are generated.",
+				                                 errors::db_error_code::INVALID_QUERY);
+			}
+			columns.erase(columns.size() - 2); // Remove last comma and space
+			const std::string table = escape_identifier(table_name);
+			const std::size_t width = first_record.size();
+
+			// Rows are copied into a staging table first, so duplicated keys are skipped instead of failing the pack
+			const std::string staging = escape_identifier("bulk_" + std::string(table_name));
+
+			std::lock_guard lock(this->conn_mutex_);
+			std::unique_ptr<pqxx::work> txn = initialize_transaction();
+			txn->exec("CREATE TEMP TABLE " + staging + " ON COMMIT DROP AS SELECT " + columns + " FROM " + table +
+			          " WITH NO DATA");
+			auto stream = pqxx::stream_to::raw_table(*txn, staging, columns);
+			std::vector<std::optional<std::string>> values;
+			values.reserve(copied_columns.size());
+			for (auto &&record: std::forward<Rec>(rows))
+			{
+				if (record.size() != width)
+				{
+					throw exceptions::QueryException("Records of bulk load have different layout.",
+					                                 errors::db_error_code::INVALID_DATA);
+				}
+				for (const std::size_t idx: generated_columns)
+				{
+					if (!is_default_uuid(record[idx]))
+					{
+						throw exceptions::QueryException("Default uuid is allowed only for the whole column.",
+						                                 errors::db_error_code::INVALID_DATA);
+					}
+				}
+				values.clear();
+				for (const std::size_t idx: copied_columns)
+				{
+					auto &&field = record[idx];
+					if (field->get_sql_type() == SqlType::UUID && field->to_string() == Uuid::null_value)
+					{
+						values.emplace_back(std::nullopt);
+					}
+					else if (is_default_uuid(field))
+					{
+						throw exceptions::QueryException("Default uuid is allowed only for the whole column.",
+						                                 errors::db_error_code::INVALID_DATA);
+					}
+					else
+					{
+						values.emplace_back(field->to_string());
+					}
+				}
+				stream.write_row(values);
+			}
+			stream.complete();
+			txn->exec("INSERT INTO " + table + " (" + columns + ") SELECT " + columns + " FROM " + staging +
+			          " ON CONFLICT DO NOTHING");
+			// Next pack of the same transaction creates it again
+			txn->exec("DROP TABLE " + staging);
+			finish_transaction(std::move(txn));
+		}
+
+		void append_param(pqxx::params &params, const FieldBase &field) const
+		{
+			if (binary_jsonb_ && field.get_sql_type() == SqlType::JSONB)
+			{
+				// Version of the jsonb binary format followed by the text
+				const std::string text = field.to_string();
+				std::basic_string<std::byte> binary;
+				binary.reserve(text.size() + 1);
+				binary.push_back(std::byte{1});
+				binary.append(reinterpret_cast<const std::byte *>(text.data()), text.size());
+				params.append(std::move(binary));
+				return;
+			}
+			params.append(field.to_string());
+		}
+
+		[[nodiscard]] static bool is_default_uuid(const std::unique_ptr<FieldBase> &field)
+		{
+			return field->get_sql_type() == SqlType::UUID && field->to_string() == Uuid::default_value;
+		}
+
 		std::string escape_identifier(std::string_view identifier) const;
 
 		std::unique_ptr<pqxx::work> initialize_transaction() const;
@@ -267,12 +497,43 @@ namespace drug_lib::common::database
 		static void build_returning_clause(std::string &query,
 		                                   const std::vector<std::shared_ptr<FieldBase>> &returning_fields);
 
+		/// @return Conjunction of the patterns for to_tsquery
+		[[nodiscard]] static std::string make_tsquery(const std::vector<PatternCondition> &patterns);
+
+		/// @return Text of postgres array with the values, elements are quoted
+		[[nodiscard]] static std::string make_array_literal(const std::vector<std::unique_ptr<FieldBase>> &values);
+
 		void conditions_to_query(std::string_view table_name, std::ostringstream &query_stream,
-		                         pqxx::params &params,
+		                         PqxxQueryParams &params,
 		                         uint32_t &param_index, const Conditions &conditions) const;
 
 		void create_fts_index_query(std::string_view table_name, std::ostringstream &index_query) const;
 
+		/// @brief Add stored search vector column to the table if it is missing or generated from other fields,
+		/// and remember columns of the table
+		void ensure_search_vector(std::string_view table_name) const;
+
+		/// @return False if the stored search vector is generated from other columns than the fields
+		[[nodiscard]] bool search_vector_matches(std::string_view table_name,
+		                                         const std::vector<std::shared_ptr<FieldBase>> &fts_fields) const;
+
+		/// @return Column list for SELECT, which hides search vector from the records
+		[[nodiscard]] std::string select_list(std::string_view table_name) const;
+
+		/// @return SELECT of the table up to WHERE, relevance columns are added for the relevance condition
+		[[nodiscard]] std::string select_clause(std::string_view table_name, const Conditions &conditions,
+		                                        PqxxQueryParams &params, uint32_t &param_index) const;
+
+		/// @throws QueryException If search fields of the table are not set up
+		[[nodiscard]] std::vector<std::shared_ptr<FieldBase>> get_search_fields(std::string_view table_name) const;
+
+		/// @return Text of the search fields as indexed by the trigram index
+		[[nodiscard]] std::string trigram_expression(std::string_view table_name) const;
+
+		/// @return Expression of the document searched in the table: stored column or computed from the fields
+		[[nodiscard]] std::string search_vector_expression(std::string_view table_name,
+		                                                   const std::vector<std::shared_ptr<FieldBase>> &fts_fields) const;
+
 		void create_trgm_index_query(std::string_view table_name, std::ostringstream &index_query) const;
 
 		static std::string make_fts_index_name(std::string_view table_name);
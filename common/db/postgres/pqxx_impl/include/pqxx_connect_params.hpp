@@ -70,6 +70,17 @@ namespace drug_lib::common::database
         {
             password_ = password;
         }
+        [[nodiscard]] bool is_binary_jsonb() const
+        {
+            return binary_jsonb_;
+        }
+
+        /// @brief Send jsonb values of inserts and upserts in the binary format
+        void set_binary_jsonb(const bool binary_jsonb)
+        {
+            binary_jsonb_ = binary_jsonb;
+        }
+
         [[nodiscard]] std::string make_connect_string() const
         {
             std::ostringstream conn_str;
@@ -87,5 +98,6 @@ namespace drug_lib::common::database
         std::string db_name_;
         std::string login_;
         std::string password_;
+        bool binary_jsonb_ = false;
     };
 }
@@ -0,0 +1,44 @@
+// pqxx_query_params.hpp
+#pragma once
+
+#include <concepts>
+#include <string>
+#include <utility>
+#include <vector>
+#include <pqxx/pqxx>
+
+namespace drug_lib::common::database
+{
+	/// @brief Parameters of a select with a copy of their text.
+	/// pqxx::pipeline takes plain statements only, the values are inlined into them from the copy
+	class PqxxQueryParams
+	{
+	public:
+		template <std::integral T>
+		void append(const T value)
+		{
+			params_.append(value);
+			texts_.push_back(std::to_string(value));
+		}
+
+		void append(std::string value)
+		{
+			texts_.push_back(value);
+			params_.append(std::move(value));
+		}
+
+		[[nodiscard]] const pqxx::params &get() const
+		{
+			return params_;
+		}
+
+		[[nodiscard]] const std::vector<std::string> &texts() const
+		{
+			return texts_;
+		}
+
+	private:
+		pqxx::params params_;
+		std::vector<std::string> texts_;
+	};
+} // namespace drug_lib::common::database
@@ -0,0 +1,64 @@
+// pqxx_row_cursor.hpp
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <pqxx/pqxx>
+
+#include "db_row_cursor.hpp"
+
+namespace drug_lib::common::database
+{
+	class PqxxClient;
+
+	/// @brief Server side cursor(DECLARE ... CURSOR) fetching rows in batches.
+	/// Keeps the connection of the client locked until it is exhausted or closed.
+	/// If the client is in a transaction, the cursor lives in it and must be closed before commit/rollback,
+	/// otherwise it uses own read only transaction and the client can't run queries from the same thread meanwhile
+	class PqxxRowCursor final : public interfaces::RowCursor
+	{
+	public:
+		/// @throws drug_lib::common::database::exceptions::DatabaseException
+		PqxxRowCursor(const PqxxClient &client, const std::string &query, const pqxx::params &params,
+		              uint32_t batch_size);
+
+		~PqxxRowCursor() override;
+
+		PqxxRowCursor(const PqxxRowCursor &) = delete;
+		PqxxRowCursor &operator=(const PqxxRowCursor &) = delete;
+
+		[[nodiscard]] std::optional<Record> next() override;
+
+		[[nodiscard]] std::unique_ptr<ViewRecord> next_view() override;
+
+		[[nodiscard]] bool exhausted() const override;
+
+		void close() override;
+
+	private:
+		const PqxxClient &client_;
+		std::unique_lock<std::recursive_mutex> lock_;
+		// Null if the cursor uses the client transaction
+		std::unique_ptr<pqxx::read_transaction> own_transaction_;
+		pqxx::transaction_base *txn_ = nullptr;
+		std::string name_;
+		uint32_t batch_size_;
+		pqxx::result batch_;
+		// Columns of the cursor query, made by the first row
+		std::shared_ptr<const ColumnMap> columns_;
+		pqxx::result::size_type position_ = 0;
+		bool last_batch_ = false;
+		bool closed_ = false;
+
+		/// @return True if the current batch has a row to return, fetches the next batch if needed
+		bool advance();
+
+		void fetch_batch();
+
+		void check_transaction() const;
+
+		[[nodiscard]] static std::string make_cursor_name();
+	};
+}
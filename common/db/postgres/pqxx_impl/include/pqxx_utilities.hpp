@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <thread>
 
 #include <pqxx_client.hpp>
@@ -43,42 +44,29 @@ namespace drug_lib::common::database::utilities
         client->commit_transaction();
     }
 
+    /// @brief Loads records through COPY in packs of flush size. The search index is dropped for the load
+    /// and rebuilt once at the end, everything runs in one transaction
     inline void bulk_insertion(const std::shared_ptr<PqxxClient>& client, const std::string_view table_name,
-                               std::vector<Record>&& records, const uint32_t flush = 1 << 14,
-                               const int8_t thread_count = 4)
+                               std::vector<Record>&& records, const uint32_t flush = 1 << 14)
     {
-        auto poster_worker = [&](const int start_index)
+        client->start_transaction();
+        client->drop_search_index(table_name);
+        std::vector<Record> pack;
+        pack.reserve(std::min<std::size_t>(flush, records.size()));
+        for (auto& record : records)
         {
-            std::vector<Record> pack;
-            pack.reserve(flush);
-            for (uint32_t i = start_index; i < records.size(); i += thread_count)
+            pack.push_back(std::move(record));
+            if (pack.size() >= flush)
             {
-                pack.push_back(std::move(records[i]));
-                if (pack.size() >= flush)
-                {
-                    client->insert(table_name, std::move(pack));
-                    pack.clear();
-                }
-            }
-            if (!pack.empty())
-            {
-                client->insert(table_name, std::move(pack));
+                client->bulk_load(table_name, std::move(pack));
                 pack.clear();
             }
-        };
-
-        std::vector<std::thread> threads;
-        threads.reserve(thread_count);
-        client->start_transaction();
-        client->drop_search_index(table_name);
-        for (int t = 0; t < thread_count; ++t)
-        {
-            threads.emplace_back(poster_worker, t); // Each thread handles a different starting point
         }
-        for (auto& thread : threads)
+        if (!pack.empty())
         {
-            thread.join();
+            client->bulk_load(table_name, std::move(pack));
         }
+        records.clear();
         client->restore_search_index(table_name);
         client->commit_transaction();
     }
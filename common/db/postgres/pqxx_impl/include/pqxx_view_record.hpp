@@ -15,9 +15,11 @@ namespace drug_lib::common::database
             return row_[static_cast<int32_t>(idx)].view();
         }
 
-        void set_row(pqxx::row&& row)
+        /// @param columns Map of the row result, see make_columns
+        void set_row(pqxx::row&& row, std::shared_ptr<const ColumnMap> columns)
         {
             row_ = std::move(row);
+            columns_ = std::move(columns);
         }
 
         [[nodiscard]] std::size_t size() const & override
@@ -27,12 +29,30 @@ namespace drug_lib::common::database
 
         [[nodiscard]] std::string name(const std::size_t idx) const & override
         {
-            return row_[static_cast<int32_t>(idx)].name();
+            return columns_->name(idx);
+        }
+
+        [[nodiscard]] std::shared_ptr<const ColumnMap> columns() const & override
+        {
+            return columns_;
+        }
+
+        /// @brief Map of the result header, made once and shared by the rows of the result
+        [[nodiscard]] static std::shared_ptr<const ColumnMap> make_columns(const pqxx::result& result)
+        {
+            std::vector<std::string> names;
+            names.reserve(result.columns());
+            for (int col = 0; col < result.columns(); ++col)
+            {
+                names.emplace_back(result.column_name(col));
+            }
+            return std::make_shared<const ColumnMap>(std::move(names));
         }
 
         PqxxViewRecord() = default;
 
     private:
         pqxx::row row_;
+        std::shared_ptr<const ColumnMap> columns_;
     };
 }
@@ -2,8 +2,14 @@
 
 #include "pqxx_client.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <chrono>
+#include <ctime>
 #include <iostream>
+#include <ranges>
 #include <regex>
 #include <sstream>
 
@@ -16,6 +22,101 @@ namespace drug_lib::common::database
 {
 	using namespace exceptions;
 	using db_err = errors::db_error_code;
+
+	namespace
+	{
+		template <typename T>
+		std::unique_ptr<FieldBase> decode_as(const pqxx::field &field)
+		{
+			return std::make_unique<Field<T>>(field.name(), field.as<T>());
+		}
+
+		std::unique_ptr<FieldBase> decode_uuid(const pqxx::field &field)
+		{
+			//WARNING All fields are identified as not primary, suppose be checked further
+			if (field.is_null())
+			{
+				return std::make_unique<Field<Uuid>>(field.name(), Uuid().set_null());
+			}
+			return std::make_unique<Field<Uuid>>(field.name(), Uuid(field.as<std::string>(), false));
+		}
+
+		std::unique_ptr<FieldBase> decode_json(const pqxx::field &field)
+		{
+			Json::Value json;
+			if (!field.is_null())
+			{
+				// Reader is reused by the thread instead of building one per cell
+				thread_local const std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+				const std::string_view text = field.view();
+				if (std::string errs; !reader->parse(text.data(), text.data() + text.size(), &json, &errs))
+				{
+					throw std::runtime_error("Failed to parse JSON: " + errs);
+				}
+			}
+			return std::make_unique<Field<Json::Value>>(field.name(), std::move(json));
+		}
+
+		/// @brief Parse "YYYY-MM-DD HH:MM:SS" prefix of the timestamp text as local time,
+		/// fractional seconds and zone suffix are ignored
+		std::chrono::system_clock::time_point parse_timestamp(const std::string_view text)
+		{
+			std::tm tm = {};
+			std::size_t position = 0;
+			auto read_number = [&](int &value, const std::size_t digits)
+			{
+				if (position + digits > text.size() ||
+					std::from_chars(text.data() + position, text.data() + position + digits, value).ptr !=
+					text.data() + position + digits)
+				{
+					throw std::invalid_argument("Failed to parse timestamp: " + std::string(text));
+				}
+				// Skip the separator
+				position += digits + 1;
+			};
+			read_number(tm.tm_year, 4);
+			read_number(tm.tm_mon, 2);
+			read_number(tm.tm_mday, 2);
+			read_number(tm.tm_hour, 2);
+			read_number(tm.tm_min, 2);
+			read_number(tm.tm_sec, 2);
+			tm.tm_year -= 1900;
+			tm.tm_mon -= 1;
+			tm.tm_isdst = -1;
+			return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+		}
+
+		std::unique_ptr<FieldBase> decode_timestamp(const pqxx::field &field)
+		{
+			return std::make_unique<Field<std::chrono::system_clock::time_point>>(
+				field.name(), parse_timestamp(field.view()));
+		}
+
+		struct NamedDecoder
+		{
+			std::string_view type_name;
+			std::unique_ptr<FieldBase> (*decode)(const pqxx::field &);
+			SqlType sql_type;
+		};
+
+		constexpr NamedDecoder field_decoders[] = {
+			{"bool", &decode_as<bool>, SqlType::BOOLEAN},
+			{"int2", &decode_as<int>, SqlType::INT},
+			{"int4", &decode_as<int>, SqlType::INT},
+			{"int8", &decode_as<int64_t>, SqlType::BIGINT},
+			{"float4", &decode_as<double>, SqlType::DOUBLE_PRECISION},
+			{"float8", &decode_as<double>, SqlType::DOUBLE_PRECISION},
+			{"text", &decode_as<std::string>, SqlType::TEXT},
+			{"varchar", &decode_as<std::string>, SqlType::TEXT},
+			{"bpchar", &decode_as<std::string>, SqlType::TEXT},
+			{"uuid", &decode_uuid, SqlType::UUID},
+			{"json", &decode_json, SqlType::JSONB},
+			{"jsonb", &decode_json, SqlType::JSONB},
+			{"timestamp", &decode_timestamp, SqlType::TIMESTAMP},
+			{"timestamptz", &decode_timestamp, SqlType::TIMESTAMP},
+		};
+	}
+
 	// Constructors
 	PqxxClient::PqxxClient(
 		const std::string_view host, const uint32_t port, const std::string_view db_name,
@@ -49,7 +150,7 @@ namespace drug_lib::common::database
 
 
 	PqxxClient::PqxxClient(const PqxxConnectParams &pr)
-		: in_transaction_(false)
+		: in_transaction_(false), binary_jsonb_(pr.is_binary_jsonb())
 	{
 		try
 		{
@@ -141,9 +242,46 @@ namespace drug_lib::common::database
 	{
 		std::lock_guard lock(this->conn_mutex_);
 		this->conn_->close();
+		this->prepared_statements_.clear();
 	}
 
 
+	void PqxxClient::set_statement_timeout(const std::chrono::milliseconds timeout)
+	{
+		if (timeout.count() > 0)
+		{
+			execute_query("SET statement_timeout = " + std::to_string(timeout.count()));
+		}
+		else
+		{
+			execute_query("RESET statement_timeout");
+		}
+	}
+
+	bool PqxxClient::is_alive() const
+	{
+		std::lock_guard lock(this->conn_mutex_);
+		if (!this->conn_ || !this->conn_->is_open())
+		{
+			return false;
+		}
+		if (this->in_transaction_)
+		{
+			// Connection is owned by the user transaction, query would interfere with it
+			return true;
+		}
+		try
+		{
+			pqxx::nontransaction txn(*this->conn_);
+			txn.exec("SELECT 1");
+			return true;
+		}
+		catch (const std::exception &)
+		{
+			return false;
+		}
+	}
+
 	std::unique_ptr<pqxx::work> PqxxClient::initialize_transaction() const
 	{
 		if (this->in_transaction_)
@@ -269,11 +407,49 @@ namespace drug_lib::common::database
 		query.resize(query.size() - 2);
 	}
 
+	std::string PqxxClient::make_array_literal(const std::vector<std::unique_ptr<FieldBase>> &values)
+	{
+		std::string literal = "{";
+		for (const auto &value: values)
+		{
+			literal += '"';
+			for (const char c: value->to_string())
+			{
+				if (c == '"' || c == '\\')
+				{
+					literal += '\\';
+				}
+				literal += c;
+			}
+			literal += "\",";
+		}
+		if (!values.empty())
+		{
+			literal.pop_back();
+		}
+		literal += '}';
+		return literal;
+	}
+
+	std::string PqxxClient::make_tsquery(const std::vector<PatternCondition> &patterns)
+	{
+		std::ostringstream tsquery_stream;
+		for (const auto &pattern: patterns)
+		{
+			tsquery_stream << pattern.get_pattern() << " & ";
+		}
+		std::string tsquery = tsquery_stream.str();
+		tsquery.erase(tsquery.size() - 3); // Remove last " & "
+		return tsquery;
+	}
+
 	void PqxxClient::conditions_to_query(
 		const std::string_view table_name, std::ostringstream &query_stream,
-		pqxx::params &params, uint32_t &param_index,
+		PqxxQueryParams &params, uint32_t &param_index,
 		const Conditions &conditions) const
 	{
+		// Relevance of the pattern conditions, ordered before the others
+		std::optional<std::string> rank_expression;
 		// lambdas
 		auto process_fields_clause = [&](const std::vector<FieldCondition> &fields_clause)
 		{
@@ -284,6 +460,13 @@ namespace drug_lib::common::database
 			for (const auto &condition: fields_clause)
 			{
 				std::string field_name = escape_identifier(condition.field()->get_name());
+				if (condition.is_list())
+				{
+					// Array type is inferred from the field, so one statement serves any number of values
+					local_stream << field_name << " " << condition.op() << "($" << param_index++ << ") AND ";
+					params.append(make_array_literal(condition.values()));
+					continue;
+				}
 				local_stream << field_name << " " << condition.op() << " $" << param_index++ << " AND ";
 				params.append(condition.value()->to_string());
 			}
@@ -299,7 +482,6 @@ namespace drug_lib::common::database
 				return query;
 			}
 			std::ostringstream local_stream;
-			std::ostringstream fts_fields_stream;
 			std::vector<std::shared_ptr<FieldBase>> fts_fields; {
 				std::lock_guard lock(this->conn_mutex_);
 				try
@@ -313,21 +495,16 @@ namespace drug_lib::common::database
 						db_err::INVALID_DATA);
 				}
 			}
-			for (const auto &field: fts_fields)
-			{
-				fts_fields_stream << "coalesce(" << field->get_name() << "::text, '') || ' ' || ";
-			}
-			std::string fields_concatenated = fts_fields_stream.str();
-			fields_concatenated.erase(fields_concatenated.size() - 11); // Remove last " || ' ' || "
-			std::ostringstream tsquery_stream;
-			for (const auto &pattern: patterns_clause)
+			const std::string vector_expression = search_vector_expression(table_name, fts_fields);
+			std::string tsquery = make_tsquery(patterns_clause);
+			local_stream << vector_expression << " @@ to_tsquery('simple', $" << param_index << ") AND ";
+			if (conditions.pattern_ranking())
 			{
-				tsquery_stream << pattern.get_pattern() << " & ";
+				// Same type as the rank of the seek page, so the rank of the anchor compares exactly
+				rank_expression = "ts_rank(" + vector_expression + ", to_tsquery('simple', $" +
+				                  std::to_string(param_index) + "))::double precision";
 			}
-			std::string tsquery = tsquery_stream.str();
-			tsquery.erase(tsquery.size() - 3); // Remove last " & "
-			local_stream << "to_tsvector('simple', " << fields_concatenated << ") @@ to_tsquery('simple', $" <<
-					param_index++ << ") AND ";
+			++param_index;
 			params.append(tsquery);
 			query = local_stream.str();
 			return query;
@@ -361,13 +538,50 @@ namespace drug_lib::common::database
 			return query;
 		};
 
+		// Limit and offset are parameters, so every page shares one prepared statement
 		auto process_paging_clause = [&](const PageCondition &paging)
 		{
 			std::ostringstream local_stream;
-			local_stream << " LIMIT " << paging.get_limit() << " OFFSET " << paging.get_offset();
+			local_stream << " LIMIT $" << param_index++;
+			params.append(paging.get_limit());
+			local_stream << " OFFSET $" << param_index++;
+			params.append(paging.get_offset());
 			return local_stream.str();
 		};
 
+		auto process_seek_clause = [&](const std::optional<SeekCondition> &seek)
+		{
+			std::optional<std::string> query;
+			if (!seek.has_value() || seek->after() == nullptr)
+			{
+				return query;
+			}
+			const std::string key = escape_identifier(seek->key()->get_name());
+			const uint32_t anchor_index = param_index++;
+			params.append(seek->after()->to_string());
+			std::ostringstream local_stream;
+			if (rank_expression.has_value())
+			{
+				if (!seek->after_rank().has_value())
+				{
+					throw QueryException("Seek page of ranked rows needs the rank of the anchor", db_err::INVALID_QUERY);
+				}
+				// Rank descends and key ascends, so the rank is negated to compare the pair as a row
+				std::array<char, 32> rank_text{};
+				char *end = std::to_chars(rank_text.data(), rank_text.data() + rank_text.size(),
+				                          seek->after_rank().value()).ptr;
+				params.append(std::string(rank_text.data(), end));
+				local_stream << "(-" << rank_expression.value() << ", " << key << ") > (-($" << param_index++ <<
+						"::double precision), $" << anchor_index << ") AND ";
+			}
+			else
+			{
+				local_stream << key << " > $" << anchor_index << " AND ";
+			}
+			query = local_stream.str();
+			return query;
+		};
+
 		auto process_similarity_clause = [&](const std::vector<SimilarityCondition> &similarity_conditions)
 
 		{
@@ -434,10 +648,41 @@ namespace drug_lib::common::database
 			// Return WHERE and ORDER BY clauses
 			return res;
 		};
+		// Either of the matches qualifies the row, so both indexes are used and no row comes twice
+		auto process_relevance_clause = [&](const std::optional<RelevanceCondition> &relevance)
+		{
+			std::optional<std::string> query;
+			if (!relevance.has_value())
+			{
+				return query;
+			}
+			const std::string vector_expression = search_vector_expression(table_name, get_search_fields(table_name));
+			std::ostringstream local_stream;
+			local_stream << "(" << vector_expression << " @@ to_tsquery('simple', $" << param_index++ << ") OR " <<
+					trigram_expression(table_name) << " % $" << param_index++ << ") AND ";
+			params.append(relevance->get_pattern());
+			params.append(relevance->get_pattern());
+			// Computed by the select clause
+			rank_expression = std::string(relevance_column);
+			query = local_stream.str();
+			return query;
+		};
+		const std::optional<SeekCondition> &seek = conditions.seek_condition();
+		if (seek.has_value() && (conditions.page_condition().has_value() || !conditions.order_by_conditions().empty() ||
+		                         !conditions.similarity_conditions().empty() ||
+		                         conditions.relevance_condition().has_value()))
+		{
+			throw QueryException(
+				"Seek page can't be combined with offset page, order by, similarity or relevance conditions",
+				db_err::INVALID_QUERY);
+		}
 		auto order_by_similarity_clause = process_similarity_clause(conditions.similarity_conditions());
-		if (const std::optional<std::string> patterns_clause = process_patterns_clause(conditions.pattern_conditions()),
-					fields_clause = process_fields_clause(conditions.fields_conditions());
-			fields_clause.has_value() || patterns_clause.has_value())
+		const std::optional<std::string> patterns_clause = process_patterns_clause(conditions.pattern_conditions());
+		const std::optional<std::string> relevance_clause = process_relevance_clause(conditions.relevance_condition());
+		const std::optional<std::string> fields_clause = process_fields_clause(conditions.fields_conditions());
+		if (const std::optional<std::string> seek_clause = process_seek_clause(seek);
+			fields_clause.has_value() || patterns_clause.has_value() || relevance_clause.has_value() ||
+			seek_clause.has_value())
 		{
 			std::ostringstream where_stream;
 			where_stream << " WHERE ";
@@ -449,15 +694,38 @@ namespace drug_lib::common::database
 			{
 				where_stream << patterns_clause.value();
 			}
+			if (relevance_clause.has_value())
+			{
+				where_stream << relevance_clause.value();
+			}
+			if (seek_clause.has_value())
+			{
+				where_stream << seek_clause.value();
+			}
 			std::string tmp = where_stream.str();
 			tmp.erase(tmp.size() - 5);
 			query_stream << tmp;
 		}
+		if (seek.has_value())
+		{
+			query_stream << " ORDER BY ";
+			if (rank_expression.has_value())
+			{
+				query_stream << rank_expression.value() << " DESC, ";
+			}
+			query_stream << escape_identifier(seek->key()->get_name()) << " ASC LIMIT $" << param_index++;
+			params.append(seek->get_limit());
+			return;
+		}
 		if (std::optional<std::string> order_by_clause = process_order_by_clause(conditions.order_by_conditions());
-			order_by_clause.has_value() || order_by_similarity_clause.has_value())
+			order_by_clause.has_value() || order_by_similarity_clause.has_value() || rank_expression.has_value())
 		{
 			std::ostringstream order_by;
 			order_by << " ORDER BY ";
+			if (rank_expression.has_value())
+			{
+				order_by << rank_expression.value() << " DESC, ";
+			}
 			if (order_by_clause.has_value())
 			{
 				order_by << order_by_clause.value();
@@ -483,7 +751,7 @@ namespace drug_lib::common::database
 		try
 		{
 			std::unique_ptr<pqxx::work> txn = initialize_transaction();
-			txn->exec_params(query_string, params);
+			execute_cached(*txn, query_string, params);
 			finish_transaction(std::move(txn));
 		}
 		catch (const std::exception &e)
@@ -516,7 +784,7 @@ namespace drug_lib::common::database
 		try
 		{
 			std::unique_ptr<pqxx::work> txn = initialize_transaction();
-			const pqxx::result response = txn->exec_params(query_string, params);
+			const pqxx::result response = execute_cached(*txn, query_string, params);
 			finish_transaction(std::move(txn));
 			return response;
 		}
@@ -542,112 +810,227 @@ namespace drug_lib::common::database
 		}
 	}
 
-	void PqxxClient::oid_preprocess()
+	std::string PqxxClient::make_prepared_statement_name(const std::size_t query_hash)
 	{
-		try
-		{
-			std::lock_guard lock(this->conn_mutex_);
-			pqxx::nontransaction txn(*this->conn_);
-			const pqxx::result r = txn.exec(
-				"SELECT typname, oid FROM pg_type WHERE typname IN ('bool', 'int2', 'int4', 'int8', "
-				"'float4', 'float8', 'text', 'varchar', 'bpchar', 'timestamp', 'timestamptz', 'uuid', 'json', 'jsonb')");
+		std::ostringstream name;
+		name << "ps_" << std::hex << query_hash;
+		return name.str();
+	}
 
-			for (const auto &row: r)
+	std::optional<std::string> PqxxClient::acquire_prepared_statement(const std::string &query_string) const
+	{
+		if (query_string.size() > prepared_statement_max_length_)
+		{
+			return std::nullopt;
+		}
+		std::lock_guard lock(this->conn_mutex_);
+		if (const uint64_t epoch = schema_epoch_.load(); epoch != this->prepared_epoch_)
+		{
+			// Another client changed the schema, plans of the statements may return the old columns
+			drop_prepared_statements();
+			this->prepared_epoch_ = epoch;
+		}
+		const std::size_t query_hash = std::hash<std::string>{}(query_string);
+		if (const auto it = this->prepared_statements_.find(query_hash);
+			it != this->prepared_statements_.end())
+		{
+			if (it->second != query_string)
 			{
-				this->type_oids_.insert({row["oid"].as<uint32_t>(), row["typname"].c_str()});
+				// Hash collision, the slot belongs to another query shape
+				++this->prepared_misses_;
+				return std::nullopt;
 			}
+			++this->prepared_hits_;
+			return make_prepared_statement_name(query_hash);
 		}
-		catch (const std::exception &e)
+		++this->prepared_misses_;
+		if (this->prepared_statements_.size() >= prepared_statements_capacity_)
 		{
-			throw adapt_exception(e);
+			return std::nullopt;
 		}
+		std::string statement_name = make_prepared_statement_name(query_hash);
+		this->conn_->prepare(statement_name, query_string);
+		this->prepared_statements_.emplace(query_hash, query_string);
+		return statement_name;
 	}
 
-	std::unique_ptr<FieldBase> PqxxClient::process_field(const pqxx::field &field) const
+	pqxx::result PqxxClient::execute_cached(pqxx::work &txn, const std::string &query_string,
+	                                        const pqxx::params &params) const
 	{
-		std::unique_ptr<FieldBase> field_ptr;
-		// Get the field's PostgreSQL type OID
-		boost::container::flat_map<uint32_t, std::string>::const_iterator type_oid; {
-			std::lock_guard lock(this->conn_mutex_);
-			type_oid = this->type_oids_.find(field.type());
-			if (type_oid == this->type_oids_.end())
-			{
-				throw std::invalid_argument("field type not found");
-			}
+		if (const std::optional<std::string> statement_name = acquire_prepared_statement(query_string))
+		{
+			return txn.exec_prepared(statement_name.value(), params);
 		}
+		return txn.exec_params(query_string, params);
+	}
 
-		// Determine the C++ type based on the PostgreSQL type OID and create the appropriate Field object
-		if (type_oid->second == "int4") // 32-bit integer
+	std::string PqxxClient::inline_params(const std::string &query_string, const PqxxQueryParams &params) const
+	{
+		std::vector<std::string> literals;
+		literals.reserve(params.texts().size());
+		for (const auto &text: params.texts())
 		{
-			field_ptr = std::make_unique<Field<int>>(field.name(), field.as<int32_t>());
-			return field_ptr;
+			literals.push_back(this->conn_->quote(text));
 		}
-		// Handle string types (text, varchar, char)
-		if (type_oid->second == "text") // Text type
+		if (const std::optional<std::string> statement_name = acquire_prepared_statement(query_string))
 		{
-			field_ptr = std::make_unique<Field<std::string>>(field.name(), field.as<std::string>());
-			return field_ptr;
+			std::string statement = "EXECUTE " + statement_name.value();
+			if (!literals.empty())
+			{
+				statement.append("(");
+				for (const auto &literal: literals)
+				{
+					statement.append(literal).append(", ");
+				}
+				statement.erase(statement.size() - 2);
+				statement.append(")");
+			}
+			return statement;
 		}
+		// One pass, so placeholders in substituted literals are not touched
+		std::string statement;
+		statement.reserve(query_string.size());
+		for (std::size_t i = 0; i < query_string.size(); ++i)
+		{
+			std::size_t end = i + 1;
+			while (end < query_string.size() && std::isdigit(static_cast<unsigned char>(query_string[end])))
+			{
+				++end;
+			}
+			if (query_string[i] != '$' || end == i + 1)
+			{
+				statement.push_back(query_string[i]);
+				continue;
+			}
+			const std::size_t index = std::stoul(query_string.substr(i + 1, end - i - 1));
+			if (index == 0 || index > literals.size())
+			{
+				throw QueryException("Query has a placeholder without parameter", db_err::INVALID_QUERY);
+			}
+			statement.append(literals[index - 1]);
+			i = end - 1;
+		}
+		return statement;
+	}
 
-		if (type_oid->second == "int8") // 64-bit integer (Bigint)
+	PqxxClient::PreparedStatementsStats PqxxClient::get_prepared_statements_stats() const
+	{
+		PreparedStatementsStats stats;
+		stats.hits = this->prepared_hits_.load();
+		stats.misses = this->prepared_misses_.load();
+		std::lock_guard lock(this->conn_mutex_);
+		stats.size = this->prepared_statements_.size();
+		return stats;
+	}
+
+	void PqxxClient::reset_prepared_statements() const
+	{
+		std::lock_guard lock(this->conn_mutex_);
+		this->prepared_epoch_ = ++schema_epoch_;
+		drop_prepared_statements();
+	}
+
+	void PqxxClient::drop_prepared_statements() const
+	{
+		std::lock_guard lock(this->conn_mutex_);
+		for (const auto &query_hash: this->prepared_statements_ | std::views::keys)
 		{
-			field_ptr = std::make_unique<Field<int64_t>>(field.name(), field.as<int64_t>());
-			return field_ptr;
+			try
+			{
+				this->conn_->unprepare(make_prepared_statement_name(query_hash));
+			}
+			catch (const std::exception &e)
+			{
+				std::cerr << "Failed to deallocate prepared statement: " << e.what() << std::endl;
+			}
 		}
+		this->prepared_statements_.clear();
+	}
 
-		// Handle float types
-		if (type_oid->second == "jsonb" || type_oid->second == "json") // Double precision (64-bit float)
+	void PqxxClient::oid_preprocess()
+	{
+		try
 		{
-			Json::Value json;
-			Json::CharReaderBuilder reader_builder;
-			std::string errs;
-			if (std::istringstream json_stream(field.c_str());
-				!parseFromStream(reader_builder, json_stream, &json, &errs))
+			std::lock_guard lock(this->conn_mutex_);
+			pqxx::nontransaction txn(*this->conn_);
+			const pqxx::result r = txn.exec(
+				"SELECT typname, oid FROM pg_type WHERE typname IN ('bool', 'int2', 'int4', 'int8', "
+				"'float4', 'float8', 'text', 'varchar', 'bpchar', 'timestamp', 'timestamptz', 'uuid', 'json', 'jsonb')");
+
+			this->decoders_.clear();
+			for (const auto &row: r)
 			{
-				throw std::runtime_error("Failed to parse JSON: " + errs);
+				const auto decoder = std::ranges::find(field_decoders, row["typname"].view(), &NamedDecoder::type_name);
+				if (decoder != std::ranges::end(field_decoders))
+				{
+					this->decoders_.emplace(row["oid"].as<uint32_t>(), TypeDecoder{decoder->decode, decoder->sql_type});
+				}
 			}
-			field_ptr = std::make_unique<Field<Json::Value>>(field.name(), json);
-			return field_ptr;
 		}
-		if (type_oid->second == "float8") // Double precision (64-bit float)
+		catch (const std::exception &e)
 		{
-			field_ptr = std::make_unique<Field<double>>(field.name(), field.as<double>());
-			return field_ptr;
+			throw adapt_exception(e);
 		}
+	}
 
-		// Handle boolean type
-		if (type_oid->second == "bool") // Boolean type
+	std::unique_ptr<FieldBase> PqxxClient::process_field(const pqxx::field &field) const
+	{
+		const auto decoder = this->decoders_.find(field.type());
+		if (decoder == this->decoders_.end())
 		{
-			field_ptr = std::make_unique<Field<bool>>(field.name(), field.as<bool>());
-			return field_ptr;
+			throw std::invalid_argument("field type not found: " + std::to_string(field.type()));
 		}
-		// Handle UUID type
-		if (type_oid->second == "uuid") // UUID type
+		return decoder->second.decode(field);
+	}
+
+	ColumnarResult PqxxClient::process_columns(const pqxx::result &result) const
+	{
+		ColumnarResult columns;
+		const auto rows = static_cast<pqxx::result::size_type>(result.size());
+		for (int col = 0; col < result.columns(); ++col)
 		{
-			//WARNING All fields are identified as not primary, suppose be checked further
-			if (field.is_null() == true)
+			const auto decoder = this->decoders_.find(result.column_type(col));
+			if (decoder == this->decoders_.end())
 			{
-				field_ptr = std::make_unique<Field<Uuid>>(field.name(), Uuid().set_null());
-				return field_ptr;
+				throw std::invalid_argument("field type not found: " + std::to_string(result.column_type(col)));
+			}
+			Column &column = columns.add_column(result.column_name(col), decoder->second.sql_type);
+			column.reserve(rows);
+			// Column by column, so each append goes to the same vector
+			for (pqxx::result::size_type row = 0; row < rows; ++row)
+			{
+				const pqxx::field field = result[row][col];
+				if (field.is_null())
+				{
+					column.append_null();
+					continue;
+				}
+				switch (column.type())
+				{
+				case SqlType::INT:
+				case SqlType::BIGINT:
+					column.append_integer(field.as<int64_t>());
+					break;
+				case SqlType::DOUBLE_PRECISION:
+					column.append_real(field.as<double>());
+					break;
+				case SqlType::BOOLEAN:
+					column.append_boolean(field.as<bool>());
+					break;
+				case SqlType::TIMESTAMP:
+					column.append_timestamp(parse_timestamp(field.view()));
+					break;
+				case SqlType::TEXT:
+				case SqlType::UUID:
+				case SqlType::JSONB:
+					column.append_text(field.view());
+					break;
+				case SqlType::UNSUPPORTED:
+					break;
+				}
 			}
-			field_ptr = std::make_unique<Field<Uuid>>(field.name(), Uuid(field.as<std::string>(), false));
-			return field_ptr;
-		}
-		// Handle timestamp types (with or without a timezone)
-		if (type_oid->second == "timestamptz" || type_oid->second == "timestamp") // Timestamp type
-		{
-			const auto value = field.as<std::string>();
-			// Parse the timestamp string into std::chrono::system_clock::time_point
-			std::istringstream iss(value);
-			std::tm tm = {};
-			iss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S"); // Parse the string to fill the tm structure
-			auto tp = std::chrono::system_clock::from_time_t(std::mktime(&tm)); // Convert to time_point
-			field_ptr = std::make_unique<Field<std::chrono::system_clock::time_point>>(field.name(), tp);
-			return field_ptr;
 		}
-
-		// Return the field pointer (nullptr if no matching type was found)
-		return field_ptr;
+		return columns;
 	}
 
 	void PqxxClient::make_unique_constraint(
@@ -757,6 +1140,11 @@ namespace drug_lib::common::database
 		query += ");";
 
 		execute_query(query);
+		// Statements prepared against the previous table definition are no longer valid
+		reset_prepared_statements(); {
+			std::lock_guard lock(this->conn_mutex_);
+			this->select_lists_.erase(std::string(table_name));
+		}
 	}
 
 	void PqxxClient::remove_table(const std::string_view table_name)
@@ -765,6 +1153,10 @@ namespace drug_lib::common::database
 		std::ostringstream query_stream;
 		query_stream << "DROP TABLE IF EXISTS " << table;
 		execute_query(query_stream.str());
+		reset_prepared_statements(); {
+			std::lock_guard lock(this->conn_mutex_);
+			this->select_lists_.erase(std::string(table_name));
+		}
 	}
 
 	bool PqxxClient::check_table(const std::string_view table_name)
@@ -797,6 +1189,36 @@ namespace drug_lib::common::database
 		execute_query(query, params);
 	}
 
+	void PqxxClient::bulk_load_implementation(const std::string_view table_name, const std::vector<Record> &rows)
+	{
+		try
+		{
+			stream_records(table_name, rows);
+		}
+		catch (const DatabaseException &)
+		{
+			throw;
+		} catch (const std::exception &e)
+		{
+			throw adapt_exception(e);
+		}
+	}
+
+	void PqxxClient::bulk_load_implementation(const std::string_view table_name, std::vector<Record> &&rows)
+	{
+		try
+		{
+			stream_records(table_name, std::move(rows));
+		}
+		catch (const DatabaseException &)
+		{
+			throw;
+		} catch (const std::exception &e)
+		{
+			throw adapt_exception(e);
+		}
+	}
+
 	// Upsert Data Implementation
 	void PqxxClient::upsert_implementation(
 		const std::string_view table_name, const std::vector<Record> &rows,
@@ -910,10 +1332,13 @@ namespace drug_lib::common::database
 
 	void PqxxClient::create_fts_index_query(const std::string_view table_name, std::ostringstream &index_query) const
 	{
-		const std::string table = escape_identifier(table_name);
+		index_query << "CREATE INDEX IF NOT EXISTS " << make_fts_index_name(table_name) << " ON " <<
+				escape_identifier(table_name) << " USING gin (" << search_vector_column << ");";
+	}
 
-		// Build the concatenated fields expression
-		std::ostringstream fields_stream;
+	void PqxxClient::ensure_search_vector(const std::string_view table_name) const
+	{
+		const std::string table = escape_identifier(table_name);
 		std::vector<std::shared_ptr<FieldBase>> fts_fields; {
 			std::lock_guard lock(this->conn_mutex_);
 			try
@@ -927,47 +1352,196 @@ namespace drug_lib::common::database
 					db_err::INVALID_DATA);
 			}
 		}
-		for (const auto &field: fts_fields)
+		if (fts_fields.empty())
 		{
-			fields_stream << "coalesce(" << escape_identifier(field->get_name()) << "::text, '') || ' ' || ";
+			throw QueryException("No valid searchable fields defined for the table.", db_err::INVALID_DATA);
 		}
-		std::string fields_concatenated = fields_stream.str();
-		fields_concatenated.erase(fields_concatenated.size() - 11); // Remove last " || ' ' || "
+		const pqxx::result columns = execute_query_with_result(
+			"SELECT column_name FROM information_schema.columns "
+			"WHERE table_schema = current_schema() AND table_name = $1 ORDER BY ordinal_position",
+			pqxx::params{std::string(table_name)});
+		if (columns.empty())
+		{
+			throw QueryException("Table for the search index doesn't exist.", db_err::INVALID_DATA);
+		}
+		bool has_search_vector = false;
+		std::string columns_list;
+		for (const auto &row: columns)
+		{
+			const auto column = row[0].as<std::string>();
+			if (column == search_vector_column)
+			{
+				has_search_vector = true;
+				continue;
+			}
+			columns_list += escape_identifier(column) + ", ";
+		}
+		columns_list.erase(columns_list.size() - 2);
+		const bool stale = has_search_vector && !search_vector_matches(table_name, fts_fields);
+		if (stale)
+		{
+			// Searchable fields were changed: the stored document and indexes over the fields are built anew
+			execute_query("ALTER TABLE " + table + " DROP COLUMN " + std::string(search_vector_column));
+			execute_query("DROP INDEX IF EXISTS " + make_trgm_index_name(table_name));
+			has_search_vector = false;
+		}
+		if (!has_search_vector)
+		{
+			std::ostringstream fields_stream;
+			for (const auto &field: fts_fields)
+			{
+				fields_stream << "coalesce(" << escape_identifier(field->get_name()) << "::text, '') || ' ' || ";
+			}
+			std::string fields_concatenated = fields_stream.str();
+			fields_concatenated.erase(fields_concatenated.size() - 11); // Remove last " || ' ' || "
+			std::ostringstream column_query;
+			column_query << "ALTER TABLE " << table << " ADD COLUMN IF NOT EXISTS " << search_vector_column <<
+					" tsvector GENERATED ALWAYS AS (to_tsvector('simple', " << fields_concatenated << ")) STORED;";
+			execute_query(column_query.str());
+			// Expression index of the tables created before the stored vector
+			execute_query("DROP INDEX IF EXISTS fts_" + std::string(table_name) + "_idx");
+			// Statements prepared with * now return the new column
+			reset_prepared_statements();
+		}
+		if (stale)
+		{
+			std::ostringstream fts_index_query;
+			create_fts_index_query(table_name, fts_index_query);
+			execute_query(fts_index_query.str());
+			std::ostringstream trgm_index_query;
+			create_trgm_index_query(table_name, trgm_index_query);
+			try
+			{
+				execute_query(trgm_index_query.str());
+			}
+			catch (const std::exception &e)
+			{
+				std::cerr << "Trigram index is not rebuilt: " << e.what() << std::endl;
+			}
+		}
+		std::lock_guard lock(this->conn_mutex_);
+		this->select_lists_[std::string(table_name)] = std::move(columns_list);
+	}
 
-		index_query << "CREATE INDEX IF NOT EXISTS " << make_fts_index_name(table_name) << " ON " << table <<
-				" USING gin (to_tsvector('simple', " << fields_concatenated << "));";
+	bool PqxxClient::search_vector_matches(const std::string_view table_name,
+	                                       const std::vector<std::shared_ptr<FieldBase>> &fts_fields) const
+	{
+		// Columns the generation expression depends on, order of the fields doesn't change what is matched
+		static const std::string query =
+			"SELECT DISTINCT ref.attname FROM pg_attribute vec "
+			"LEFT JOIN pg_attrdef def ON def.adrelid = vec.attrelid AND def.adnum = vec.attnum "
+			"JOIN pg_depend dep ON dep.refclassid = 'pg_class'::regclass AND dep.refobjid = vec.attrelid AND "
+			"((dep.classid = 'pg_class'::regclass AND dep.objid = vec.attrelid AND dep.objsubid = vec.attnum) OR "
+			"(dep.classid = 'pg_attrdef'::regclass AND dep.objid = def.oid)) "
+			"JOIN pg_attribute ref ON ref.attrelid = dep.refobjid AND ref.attnum = dep.refobjsubid "
+			"WHERE vec.attrelid = to_regclass($1) AND vec.attname = $2 AND ref.attnum <> vec.attnum";
+		const pqxx::result res = execute_query_with_result(
+			query, pqxx::params{escape_identifier(table_name), std::string(search_vector_column)});
+		std::vector<std::string> stored;
+		stored.reserve(res.size());
+		for (const auto &row: res)
+		{
+			stored.push_back(row[0].as<std::string>());
+		}
+		std::vector<std::string> requested;
+		requested.reserve(fts_fields.size());
+		for (const auto &field: fts_fields)
+		{
+			requested.push_back(field->get_name());
+		}
+		std::ranges::sort(stored);
+		std::ranges::sort(requested);
+		requested.erase(std::ranges::unique(requested).begin(), requested.end());
+		return stored == requested;
 	}
 
-	void PqxxClient::create_trgm_index_query(const std::string_view table_name, std::ostringstream &index_query) const
+	std::string PqxxClient::select_list(const std::string_view table_name) const
 	{
-		const std::string table = escape_identifier(table_name);
+		std::lock_guard lock(this->conn_mutex_);
+		if (const auto it = this->select_lists_.find(std::string(table_name)); it != this->select_lists_.end())
+		{
+			return it->second;
+		}
+		return "*";
+	}
 
-		// Build the concatenated fields expression
-		std::ostringstream fields_stream;
-		std::vector<std::shared_ptr<FieldBase>> trgm_fields; {
+	std::string PqxxClient::search_vector_expression(const std::string_view table_name,
+	                                                 const std::vector<std::shared_ptr<FieldBase>> &fts_fields) const
+	{ {
 			std::lock_guard lock(this->conn_mutex_);
-			try
-			{
-				trgm_fields = this->search_fields_.at(table_name.data());
-			}
-			catch (std::out_of_range &)
+			if (this->select_lists_.contains(std::string(table_name)))
 			{
-				throw QueryException(
-					"For this table trigram index is not set up or disabled. Or invalid table name credentials",
-					db_err::INVALID_DATA);
+				return std::string(search_vector_column);
 			}
 		}
-		for (const auto &field: trgm_fields)
+		std::ostringstream fts_fields_stream;
+		for (const auto &field: fts_fields)
+		{
+			fts_fields_stream << "coalesce(" << field->get_name() << "::text, '') || ' ' || ";
+		}
+		std::string fields_concatenated = fts_fields_stream.str();
+		fields_concatenated.erase(fields_concatenated.size() - 11); // Remove last " || ' ' || "
+		return "to_tsvector('simple', " + fields_concatenated + ")";
+	}
+
+	void PqxxClient::create_trgm_index_query(const std::string_view table_name, std::ostringstream &index_query) const
+	{
+		index_query << "CREATE INDEX IF NOT EXISTS " << make_trgm_index_name(table_name) << " ON " <<
+				escape_identifier(table_name) << " USING gin ((" << trigram_expression(table_name) << ") gin_trgm_ops);";
+	}
+
+	std::vector<std::shared_ptr<FieldBase>> PqxxClient::get_search_fields(const std::string_view table_name) const
+	{
+		std::lock_guard lock(this->conn_mutex_);
+		const auto it = this->search_fields_.find(std::string(table_name));
+		if (it == this->search_fields_.end() || it->second.empty())
+		{
+			throw QueryException(
+				"For this table search fields are not set up or disabled. Or invalid table name credentials",
+				db_err::INVALID_DATA);
+		}
+		return it->second;
+	}
+
+	std::string PqxxClient::trigram_expression(const std::string_view table_name) const
+	{
+		std::ostringstream fields_stream;
+		for (const auto &field: get_search_fields(table_name))
 		{
 			fields_stream << "coalesce(" << escape_identifier(field->get_name()) << "::text, '') || ' ' || ";
 		}
 		std::string fields_concatenated = fields_stream.str();
 		fields_concatenated.erase(fields_concatenated.size() - 11); // Remove last " || ' ' || "
-
-		index_query << "CREATE INDEX IF NOT EXISTS " << make_trgm_index_name(table_name) << " ON " << table <<
-				" USING gin ((" << fields_concatenated << ") gin_trgm_ops);";
+		return fields_concatenated;
 	}
 
+	std::string PqxxClient::select_clause(const std::string_view table_name, const Conditions &conditions,
+	                                      PqxxQueryParams &params, uint32_t &param_index) const
+	{
+		std::ostringstream clause;
+		clause << "SELECT " << select_list(table_name);
+		if (const std::optional<RelevanceCondition> &relevance = conditions.relevance_condition(); relevance.has_value())
+		{
+			const std::string vector_expression = search_vector_expression(table_name, get_search_fields(table_name));
+			const std::string tsquery = "to_tsquery('simple', $" + std::to_string(param_index++) + ")";
+			params.append(relevance->get_pattern());
+			clause << ", (ts_rank(" << vector_expression << ", " << tsquery << ") + similarity(" <<
+					trigram_expression(table_name) << ", $" << param_index++ << "))::double precision AS " <<
+					relevance_column << ", " <<
+					vector_expression << " @@ " << tsquery << " AS " << exact_match_column;
+			params.append(relevance->get_pattern());
+		}
+		if (conditions.seek_condition().has_value() && conditions.pattern_ranking() &&
+		    !conditions.pattern_conditions().empty())
+		{
+			const std::string vector_expression = search_vector_expression(table_name, get_search_fields(table_name));
+			clause << ", ts_rank(" << vector_expression << ", to_tsquery('simple', $" << param_index++ <<
+					"))::double precision AS " << seek_rank_column;
+			params.append(make_tsquery(conditions.pattern_conditions()));
+		}
+		clause << " FROM " << escape_identifier(table_name);
+		return clause.str();
+	}
 
 	void PqxxClient::setup_search_index(
 		const std::string_view table_name,
@@ -982,6 +1556,7 @@ namespace drug_lib::common::database
 		}
 		try
 		{
+			ensure_search_vector(table_name);
 			std::ostringstream fts_index_query;
 			create_fts_index_query(table_name, fts_index_query);
 			execute_query(fts_index_query.str());
@@ -1028,14 +1603,28 @@ namespace drug_lib::common::database
 	{ {
 			std::lock_guard lock(this->conn_mutex_);
 			this->search_fields_[std::string(table_name)].clear();
+			this->select_lists_.erase(std::string(table_name));
 		}
 		drop_search_index(table_name);
+		try
+		{
+			std::ostringstream column_query;
+			column_query << "ALTER TABLE IF EXISTS " << escape_identifier(table_name) << " DROP COLUMN IF EXISTS " <<
+					search_vector_column;
+			execute_query(column_query.str());
+			reset_prepared_statements();
+		}
+		catch (const std::exception &e)
+		{
+			throw adapt_exception(e);
+		}
 	}
 
 	void PqxxClient::restore_search_index(const std::string_view table_name) const
 	{
 		try
 		{
+			ensure_search_vector(table_name);
 			std::ostringstream index_query;
 			create_fts_index_query(table_name, index_query);
 			execute_query(index_query.str());
@@ -1068,15 +1657,13 @@ namespace drug_lib::common::database
 				db_err::INVALID_QUERY);
 		}
 		std::vector<Record> results;
-		const std::string table = escape_identifier(table_name);
 		std::ostringstream query_stream;
 
-		pqxx::params params;
-		query_stream << "SELECT * FROM " << table;
-
+		PqxxQueryParams params;
 		uint32_t param_index = 1;
+		query_stream << select_clause(table_name, conditions, params, param_index);
 		conditions_to_query(table_name, query_stream, params, param_index, conditions);
-		const pqxx::result res = execute_query_with_result(query_stream.str(), params);
+		const pqxx::result res = execute_query_with_result(query_stream.str(), params.get());
 		results.reserve(res.size());
 		for (const auto &row: res)
 		{
@@ -1102,19 +1689,19 @@ namespace drug_lib::common::database
 				db_err::INVALID_QUERY);
 		}
 		std::vector<std::unique_ptr<ViewRecord>> results;
-		const std::string table = escape_identifier(table_name);
 		std::ostringstream query_stream;
 
-		pqxx::params params;
-		query_stream << "SELECT * FROM " << table;
+		PqxxQueryParams params;
 		uint32_t param_index = 1;
+		query_stream << select_clause(table_name, conditions, params, param_index);
 		conditions_to_query(table_name, query_stream, params, param_index, conditions);
-		pqxx::result res = execute_query_with_result(query_stream.str(), params);
+		pqxx::result res = execute_query_with_result(query_stream.str(), params.get());
 		results.reserve(res.size());
+		const auto columns = PqxxViewRecord::make_columns(res);
 		for (auto &&row: std::move(res))
 		{
 			auto record = std::make_unique<PqxxViewRecord>();
-			record->set_row(std::move(row));
+			record->set_row(std::move(row), columns);
 			results.push_back(std::move(record));
 		}
 		return results;
@@ -1125,8 +1712,8 @@ namespace drug_lib::common::database
 		std::vector<Record> results;
 		const std::string table = escape_identifier(table_name);
 		std::ostringstream query_stream;
-		query_stream << "SELECT * FROM " << table;
-		const pqxx::result res = execute_query_with_result(query_stream.str());
+		query_stream << "SELECT " << select_list(table_name) << " FROM " << table;
+		const pqxx::result res = execute_query_with_result(query_stream.str(), pqxx::params{});
 		results.reserve(res.size());
 		for (const auto &row: res)
 		{
@@ -1146,18 +1733,131 @@ namespace drug_lib::common::database
 		std::vector<std::unique_ptr<ViewRecord>> results;
 		const std::string table = escape_identifier(table_name);
 		std::ostringstream query_stream;
-		query_stream << "SELECT * FROM " << table;
-		pqxx::result res = execute_query_with_result(query_stream.str());
+		query_stream << "SELECT " << select_list(table_name) << " FROM " << table;
+		pqxx::result res = execute_query_with_result(query_stream.str(), pqxx::params{});
 		results.reserve(res.size());
+		const auto columns = PqxxViewRecord::make_columns(res);
 		for (auto &&row: std::move(res))
 		{
 			auto record = std::make_unique<PqxxViewRecord>();
-			record->set_row(std::move(row));
+			record->set_row(std::move(row), columns);
 			results.push_back(std::move(record));
 		}
 		return results;
 	}
 
+	ColumnarResult PqxxClient::select_columns(const std::string_view table_name, const Conditions &conditions) const
+	{
+		std::ostringstream query_stream;
+		PqxxQueryParams params;
+		uint32_t param_index = 1;
+		query_stream << select_clause(table_name, conditions, params, param_index);
+		if (!conditions.empty())
+		{
+			conditions_to_query(table_name, query_stream, params, param_index, conditions);
+		}
+		return process_columns(execute_query_with_result(query_stream.str(), params.get()));
+	}
+
+	ColumnarResult PqxxClient::select_columns(const std::string_view table_name) const
+	{
+		return select_columns(table_name, Conditions{});
+	}
+
+	std::vector<std::vector<std::unique_ptr<ViewRecord>>> PqxxClient::view_batch(
+		const std::vector<interfaces::ViewQuery> &queries) const
+	{
+		std::lock_guard lock(this->conn_mutex_);
+		std::vector<std::vector<std::unique_ptr<ViewRecord>>> results;
+		results.reserve(queries.size());
+		try
+		{
+			// Statements are prepared before the pipeline occupies the connection
+			std::vector<std::string> statements;
+			statements.reserve(queries.size());
+			for (const auto &[table_name, conditions]: queries)
+			{
+				std::ostringstream query_stream;
+				PqxxQueryParams params;
+				uint32_t param_index = 1;
+				query_stream << select_clause(table_name, conditions, params, param_index);
+				if (!conditions.empty())
+				{
+					conditions_to_query(table_name, query_stream, params, param_index, conditions);
+				}
+				statements.push_back(inline_params(query_stream.str(), params));
+			}
+			std::unique_ptr<pqxx::work> txn = initialize_transaction();
+			std::vector<pqxx::result> responses;
+			responses.reserve(statements.size());
+			{
+				pqxx::pipeline pipeline(*txn);
+				// Hold all queries back and send them in one flush
+				pipeline.retain(static_cast<int>(statements.size()) + 1);
+				std::vector<pqxx::pipeline::query_id> query_ids;
+				query_ids.reserve(statements.size());
+				for (const auto &statement: statements)
+				{
+					query_ids.push_back(pipeline.insert(statement));
+				}
+				pipeline.resume();
+				for (const auto query_id: query_ids)
+				{
+					responses.push_back(pipeline.retrieve(query_id));
+				}
+				pipeline.complete();
+			}
+			finish_transaction(std::move(txn));
+			for (auto &response: responses)
+			{
+				std::vector<std::unique_ptr<ViewRecord>> rows;
+				rows.reserve(response.size());
+				const auto columns = PqxxViewRecord::make_columns(response);
+				for (auto &&row: std::move(response))
+				{
+					auto record = std::make_unique<PqxxViewRecord>();
+					record->set_row(std::move(row), columns);
+					rows.push_back(std::move(record));
+				}
+				results.push_back(std::move(rows));
+			}
+		}
+		catch (const DatabaseException &)
+		{
+			throw;
+		} catch (const std::exception &e)
+		{
+			throw adapt_exception(e);
+		}
+		return results;
+	}
+
+	std::unique_ptr<interfaces::RowCursor> PqxxClient::stream(
+		const std::string_view table_name,
+		const Conditions &conditions,
+		const uint32_t batch_size) const
+	{
+		if (batch_size == 0)
+		{
+			throw QueryException("Batch size of the cursor must be positive", db_err::INVALID_QUERY);
+		}
+		std::ostringstream query_stream;
+		PqxxQueryParams params;
+		uint32_t param_index = 1;
+		query_stream << select_clause(table_name, conditions, params, param_index);
+		if (!conditions.empty())
+		{
+			conditions_to_query(table_name, query_stream, params, param_index, conditions);
+		}
+		return std::make_unique<PqxxRowCursor>(*this, query_stream.str(), params.get(), batch_size);
+	}
+
+	std::unique_ptr<interfaces::RowCursor> PqxxClient::stream(const std::string_view table_name,
+	                                                          const uint32_t batch_size) const
+	{
+		return stream(table_name, Conditions{}, batch_size);
+	}
+
 
 	void PqxxClient::remove(const std::string_view table_name, const Conditions &conditions)
 	{
@@ -1169,12 +1869,12 @@ namespace drug_lib::common::database
 		}
 		const std::string table = escape_identifier(table_name);
 		std::ostringstream query_stream;
-		pqxx::params params;
+		PqxxQueryParams params;
 		query_stream << "DELETE FROM " << table;
 		uint32_t param_index = 1;
 		conditions_to_query(table_name, query_stream, params, param_index, conditions);
 
-		execute_query(query_stream.str(), params);
+		execute_query(query_stream.str(), params.get());
 	}
 
 	uint32_t PqxxClient::count(const std::string_view table_name) const
@@ -1183,7 +1883,7 @@ namespace drug_lib::common::database
 		std::ostringstream query_stream;
 		query_stream << "SELECT COUNT(*) FROM " << table;
 		// Execute the query
-		const pqxx::result res = execute_query_with_result(query_stream.str());
+		const pqxx::result res = execute_query_with_result(query_stream.str(), pqxx::params{});
 
 		return res[0][0].as<uint32_t>();
 	}
@@ -1201,19 +1901,51 @@ namespace drug_lib::common::database
 		// Start building the query
 		query_stream << "SELECT COUNT(*) FROM " << table;
 		// Add conditions if any
-		pqxx::params params;
+		PqxxQueryParams params;
 		uint32_t param_index = 1;
 		conditions_to_query(table_name, query_stream, params, param_index, conditions);
-		const pqxx::result res = execute_query_with_result(query_stream.str(), params);
+		const pqxx::result res = execute_query_with_result(query_stream.str(), params.get());
 		return res[0][0].as<uint32_t>();
 	}
 
+	uint32_t PqxxClient::estimate_count(const std::string_view table_name) const
+	{
+		// Same extrapolation as the planner does, the table may have grown since it was analyzed
+		static const std::string query =
+			"SELECT (c.reltuples / c.relpages * (pg_relation_size(c.oid) / current_setting('block_size')::int))::bigint "
+			"FROM pg_class c WHERE c.oid = to_regclass($1) AND c.reltuples >= 0 AND c.relpages > 0";
+		const pqxx::result res = execute_query_with_result(query, pqxx::params{escape_identifier(table_name)});
+		if (res.empty() || res[0][0].is_null())
+		{
+			// Never analyzed, or empty when it was
+			return count(table_name);
+		}
+		return static_cast<uint32_t>(std::clamp<int64_t>(res[0][0].as<int64_t>(), 0, UINT32_MAX));
+	}
+
 	void PqxxClient::set_search_fields(
 		const std::string_view table_name,
 		std::vector<std::shared_ptr<FieldBase>> fields)
 	{
-		std::lock_guard lock(this->conn_mutex_);
-		this->search_fields_[std::string(table_name)] = std::move(fields);
+		const bool searchable = !fields.empty(); {
+			std::lock_guard lock(this->conn_mutex_);
+			this->search_fields_[std::string(table_name)] = std::move(fields);
+		}
+		if (searchable)
+		{
+			try
+			{
+				ensure_search_vector(table_name);
+			}
+			catch (const DatabaseException &)
+			{
+				throw;
+			}
+			catch (const std::exception &e)
+			{
+				throw adapt_exception(e);
+			}
+		}
 	}
 
 	void PqxxClient::set_conflict_fields(
@@ -1227,7 +1959,7 @@ namespace drug_lib::common::database
 	std::string PqxxClient::make_fts_index_name(const std::string_view table_name)
 	{
 		std::ostringstream fts_ind;
-		fts_ind << "fts_" << table_name << "_idx";
+		fts_ind << "fts_" << table_name << "_vector_idx";
 		return fts_ind.str();
 	}
 
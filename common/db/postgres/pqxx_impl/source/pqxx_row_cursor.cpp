@@ -0,0 +1,172 @@
+// pqxx_row_cursor.cpp
+
+#include "pqxx_row_cursor.hpp"
+
+#include <atomic>
+#include <iostream>
+
+#include "pqxx_client.hpp"
+#include "pqxx_view_record.hpp"
+
+namespace drug_lib::common::database
+{
+	using namespace exceptions;
+	using db_err = errors::db_error_code;
+
+	PqxxRowCursor::PqxxRowCursor(const PqxxClient &client, const std::string &query, const pqxx::params &params,
+	                             const uint32_t batch_size)
+		: client_(client), lock_(client.conn_mutex_), name_(make_cursor_name()), batch_size_(batch_size)
+	{
+		try
+		{
+			if (client_.in_transaction_)
+			{
+				txn_ = client_.open_transaction_.get();
+			}
+			else
+			{
+				own_transaction_ = std::make_unique<pqxx::read_transaction>(*client_.conn_);
+				txn_ = own_transaction_.get();
+			}
+			txn_->exec_params("DECLARE " + name_ + " NO SCROLL CURSOR FOR " + query, params);
+		}
+		catch (const std::exception &e)
+		{
+			throw PqxxClient::adapt_exception(e);
+		}
+	}
+
+	PqxxRowCursor::~PqxxRowCursor()
+	{
+		try
+		{
+			close();
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Failed to close cursor " << name_ << ": " << e.what() << std::endl;
+		}
+	}
+
+	std::optional<Record> PqxxRowCursor::next()
+	{
+		if (!advance())
+		{
+			return std::nullopt;
+		}
+		const pqxx::row row = batch_[position_++];
+		Record record;
+		record.reserve(row.size());
+		for (const auto &field: row)
+		{
+			record.push_back(client_.process_field(field));
+		}
+		return record;
+	}
+
+	std::unique_ptr<ViewRecord> PqxxRowCursor::next_view()
+	{
+		if (!advance())
+		{
+			return nullptr;
+		}
+		if (!columns_)
+		{
+			// Batches of one cursor have the same columns
+			columns_ = PqxxViewRecord::make_columns(batch_);
+		}
+		auto record = std::make_unique<PqxxViewRecord>();
+		record->set_row(batch_[position_++], columns_);
+		return record;
+	}
+
+	bool PqxxRowCursor::exhausted() const
+	{
+		return closed_ || (last_batch_ && position_ >= batch_.size());
+	}
+
+	void PqxxRowCursor::close()
+	{
+		if (closed_)
+		{
+			return;
+		}
+		closed_ = true;
+		batch_.clear();
+		position_ = 0;
+		try
+		{
+			if (own_transaction_)
+			{
+				// Cursor dies with its transaction
+				own_transaction_->commit();
+				own_transaction_.reset();
+			}
+			else if (client_.in_transaction_ && client_.open_transaction_.get() == txn_)
+			{
+				txn_->exec("CLOSE " + name_);
+			}
+		}
+		catch (const std::exception &e)
+		{
+			txn_ = nullptr;
+			lock_.unlock();
+			throw PqxxClient::adapt_exception(e);
+		}
+		txn_ = nullptr;
+		lock_.unlock();
+	}
+
+	bool PqxxRowCursor::advance()
+	{
+		if (closed_)
+		{
+			return false;
+		}
+		if (position_ < batch_.size())
+		{
+			return true;
+		}
+		if (!last_batch_)
+		{
+			fetch_batch();
+		}
+		if (position_ < batch_.size())
+		{
+			return true;
+		}
+		// Release the connection as soon as the result is exhausted
+		close();
+		return false;
+	}
+
+	void PqxxRowCursor::fetch_batch()
+	{
+		check_transaction();
+		try
+		{
+			batch_ = txn_->exec("FETCH FORWARD " + std::to_string(batch_size_) + " FROM " + name_);
+		}
+		catch (const std::exception &e)
+		{
+			throw PqxxClient::adapt_exception(e);
+		}
+		position_ = 0;
+		last_batch_ = static_cast<uint32_t>(batch_.size()) < batch_size_;
+	}
+
+	void PqxxRowCursor::check_transaction() const
+	{
+		if (!own_transaction_ && (!client_.in_transaction_ || client_.open_transaction_.get() != txn_))
+		{
+			throw TransactionException("Transaction of the cursor was finished before the cursor",
+			                           db_err::TRANSACTION_COMMIT_FAILED);
+		}
+	}
+
+	std::string PqxxRowCursor::make_cursor_name()
+	{
+		static std::atomic<uint64_t> cursor_counter{0};
+		return "drug_lib_cursor_" + std::to_string(cursor_counter.fetch_add(1));
+	}
+}
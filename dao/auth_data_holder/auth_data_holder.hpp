@@ -155,6 +155,27 @@ namespace drug_lib::dao
 			this->setup();
 		}
 
+		/// @brief Same as set_connection, kept for HandbookProvider
+		void prepare(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
+		{
+			set_connection(connect);
+		}
+
+		/// @brief Copy working on another connection without setup. The connection must be prepared before
+		[[nodiscard]] AuthDataHolder bind(std::shared_ptr<common::database::interfaces::DbInterface> connect) const
+		{
+			AuthDataHolder bound(*this);
+			bound.connect_ = std::move(connect);
+			bound.used_pool.reset();
+			return bound;
+		}
+
+		/// @brief Create the table and register the holder fields in the connection
+		static void prepare_connection(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
+		{
+			AuthDataHolder().prepare(connect);
+		}
+
 		void drop_connection()
 		{
 			if (used_pool)
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <db_interface_pool.hpp>
+
+namespace drug_lib::dao
+{
+    template <typename T>
+    concept BindableHolder = requires(T holder, const T const_holder,
+                                      const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
+    {
+        holder.prepare(connect);
+        { const_holder.bind(connect) } -> std::same_as<T>;
+        T::prepare_connection(connect);
+    };
+
+    /// @brief Gives each request own handbooks. With a pool every session leases a connection until it is destroyed,
+    /// so concurrent requests don't wait for each other on one connection.
+    /// With a single connection all sessions share it
+    template <BindableHolder Holder>
+    class HandbookProvider final
+    {
+    public:
+        class Session
+        {
+        public:
+            Session(common::database::creational::DbInterfacePool::Lease&& lease, Holder&& holder)
+                : lease_(std::move(lease)), holder_(std::move(holder))
+            {
+            }
+
+            Holder* operator->()
+            {
+                return &holder_;
+            }
+
+            Holder& operator*()
+            {
+                return holder_;
+            }
+
+        private:
+            // Declared first: the connection returns to the pool after holder is destroyed
+            common::database::creational::DbInterfacePool::Lease lease_;
+            Holder holder_;
+        };
+
+        /// @brief Adjust the handbooks all sessions are copied from, e.g. enable caches shared by the sessions
+        template <typename Func>
+            requires std::invocable<Func&, Holder&>
+        void configure(Func&& func)
+        {
+            func(*prototype_);
+        }
+
+        /// @brief Handbooks all sessions are copied from, e.g. for query building or metrics of the shared caches.
+        /// Has no connection when the pool is used, queries go through sessions
+        [[nodiscard]] const Holder& prototype() const
+        {
+            return *prototype_;
+        }
+
+        void setup_from_one(const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
+        {
+            prototype_->prepare(connect);
+            connect_ = connect;
+            pool_.reset();
+        }
+
+        /// @brief Prepare all connections of the pool for the holder and lease them per session
+        void setup_from_pool(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+        {
+            pool->set_initializer(&Holder::prepare_connection);
+            {
+                // Connection is already prepared by the initializer, setup here only declares holder fields
+                const auto lease = pool->lease();
+                prototype_->prepare(lease.get());
+            }
+            // Leased connection is back in the pool, the prototype must not keep using it
+            prototype_.emplace(prototype_->bind(nullptr));
+            connect_.reset();
+            pool_ = std::move(pool);
+        }
+
+        /// @throws drug_lib::common::database::exceptions::ConnectionException If the pool has no free connection in time
+        [[nodiscard]] Session session() const
+        {
+            if (pool_)
+            {
+                auto lease = pool_->lease();
+                Holder holder = prototype_->bind(lease.get());
+                return {std::move(lease), std::move(holder)};
+            }
+            if (!connect_)
+            {
+                throw std::runtime_error("Cannot connect to database interface.");
+            }
+            return {common::database::creational::DbInterfacePool::Lease{}, prototype_->bind(connect_)};
+        }
+
+    private:
+        // Rebuilt without connection by setup_from_pool, holders aren't assignable
+        std::optional<Holder> prototype_{std::in_place};
+        std::shared_ptr<common::database::interfaces::DbInterface> connect_;
+        std::shared_ptr<common::database::creational::DbInterfacePool> pool_;
+    };
+}
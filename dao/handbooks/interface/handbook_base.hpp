@@ -1,13 +1,24 @@
 #pragma once
 
+#include <charconv>
+#include <concepts>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common_object.hpp"
 #include "db_conditions.hpp"
 #include "db_interface.hpp"
+#include "db_record_arena.hpp"
 #include "error_codes.hpp"
 #include "exceptions.hpp"
+#include "object_schema.hpp"
+#include "record_cache.hpp"
 
 namespace drug_lib::dao
 {
@@ -25,17 +36,22 @@ namespace drug_lib::dao
 			{
 				{ a.to_record() } -> std::same_as<common::database::Record>;
 				{a.from_record(record)} -> std::same_as<void>;
+				T::schema();
+				T::bind(std::declval<const common::database::ColumnMap &>());
 			};
 
 	template <RecordTypeConcept RecordType>
 	class HandbookBase
 	{
 	protected:
+		static constexpr uint32_t stream_batch_size = 1 << 10;
 		std::shared_ptr<common::database::interfaces::DbInterface> connect_;
 		std::string table_name_;
 		std::vector<std::shared_ptr<common::database::FieldBase>> fts_fields_;
 		std::vector<std::shared_ptr<common::database::FieldBase>> key_fields_;
 		std::vector<std::shared_ptr<common::database::FieldBase>> value_fields_;
+		// Shared by the copies of the handbook, e.g. sessions of HandbookProvider
+		std::shared_ptr<RecordCache<RecordType>> cache_;
 
 		virtual void setup() &
 		{
@@ -43,15 +59,17 @@ namespace drug_lib::dao
 			{
 				throw std::runtime_error("Cannot connect to database interface.");
 			}
-			// creating fields
-			const auto id_field = common::database::make_field_shared<common::database::Uuid>(data::objects::shared::field_name::id);
+			// Columns are declared by the schema of the record type, properties column is common for all of them
+			fts_fields_.clear();
+			key_fields_.clear();
+			value_fields_.clear();
+			static constexpr auto schema = RecordType::schema();
+			schema.declare(key_fields_, value_fields_);
 			const auto properties_field = common::database::make_field_shared<Json::Value>(
 				data::objects::shared::field_name::properties);
-			fts_fields_.push_back(id_field);
-			fts_fields_.push_back(properties_field);
 			value_fields_.push_back(properties_field);
-
-			key_fields_.push_back(id_field);
+			fts_fields_.push_back(key_fields_.front());
+			fts_fields_.push_back(properties_field);
 
 			if (!table_name_.empty())
 			{
@@ -82,6 +100,75 @@ namespace drug_lib::dao
 
 		virtual void tear_down() = 0;
 
+		/// @brief Last row of the seek page, the next page starts after it
+		struct PageAnchor
+		{
+			std::string key;
+			double rank = 0;
+		};
+
+		/// @brief Token hides the anchor key and rank, so clients don't depend on its format
+		[[nodiscard]] static std::string encode_page_token(const std::string &key, const std::string_view rank)
+		{
+			static constexpr char digits[] = "0123456789abcdef";
+			const std::string anchor = key + '/' + std::string(rank);
+			std::string token;
+			token.reserve(anchor.size() * 2);
+			for (const unsigned char c: anchor)
+			{
+				token.push_back(digits[c >> 4]);
+				token.push_back(digits[c & 0xF]);
+			}
+			return token;
+		}
+
+		/// @throws std::invalid_argument If the token is malformed
+		[[nodiscard]] static PageAnchor decode_page_token(const std::string &token)
+		{
+			auto digit = [](const char c) -> int
+			{
+				if (c >= '0' && c <= '9')
+				{
+					return c - '0';
+				}
+				if (c >= 'a' && c <= 'f')
+				{
+					return c - 'a' + 10;
+				}
+				throw std::invalid_argument("Malformed page token");
+			};
+			if (token.size() % 2 != 0)
+			{
+				throw std::invalid_argument("Malformed page token");
+			}
+			std::string anchor;
+			anchor.reserve(token.size() / 2);
+			for (std::size_t i = 0; i < token.size(); i += 2)
+			{
+				anchor.push_back(static_cast<char>(digit(token[i]) << 4 | digit(token[i + 1])));
+			}
+			const std::size_t separator = anchor.rfind('/');
+			if (separator == std::string::npos)
+			{
+				throw std::invalid_argument("Malformed page token");
+			}
+			PageAnchor result;
+			const char *rank_end = anchor.data() + anchor.size();
+			if (const auto [end, ec] = std::from_chars(anchor.data() + separator + 1, rank_end, result.rank);
+				ec != std::errc{} || end != rank_end)
+			{
+				throw std::invalid_argument("Malformed page token");
+			}
+			result.key = anchor.substr(0, separator);
+			return result;
+		}
+
+		/// @brief Ids are read back from the table in the canonical form, keys of the requested ids must match them
+		[[nodiscard]] static std::string key_of(const std::string &id)
+		{
+			return common::database::Uuid(id, false).canonical_id();
+		}
+
 	public:
 		virtual ~HandbookBase() = default;
 
@@ -111,6 +198,10 @@ namespace drug_lib::dao
 			std::vector<common::database::Record> db_records;
 			db_records.push_back(record.to_record());
 			connect_->upsert(table_name_, std::move(db_records), value_fields_);
+			if (cache_)
+			{
+				cache_->invalidate(key_of(record.get_id()));
+			}
 		}
 
 		void force_insert(const std::vector<RecordType> &records)
@@ -122,6 +213,52 @@ namespace drug_lib::dao
 				db_records.push_back(record.to_record());
 			}
 			connect_->upsert(table_name_, std::move(db_records), value_fields_);
+			if (cache_)
+			{
+				for (const auto &record: records)
+				{
+					cache_->invalidate(key_of(record.get_id()));
+				}
+			}
+		}
+
+		/// @brief Loads records through the bulk path of the connection. Intended for imports: no returning and
+		/// no conflict resolution, records with taken keys are skipped
+		void bulk_load(const std::vector<RecordType> &records)
+		{
+			if (records.empty())
+			{
+				return;
+			}
+			std::vector<common::database::Record> db_records;
+			db_records.reserve(records.size());
+			for (const auto &record: records)
+			{
+				db_records.push_back(record.to_record());
+			}
+			connect_->bulk_load(table_name_, std::move(db_records));
+		}
+
+		/// @brief Same as insert, fields of the records are carved from the arena instead of the heap
+		void insert(const std::vector<RecordType> &records, common::database::RecordArena &arena)
+		{
+			common::database::RecordArena::Scope scope(arena);
+			insert(records);
+		}
+
+		/// @brief Same as force_insert, fields of the records are carved from the arena instead of the heap
+		void force_insert(const std::vector<RecordType> &records, common::database::RecordArena &arena)
+		{
+			common::database::RecordArena::Scope scope(arena);
+			force_insert(records);
+		}
+
+		/// @brief Same as bulk_load, fields of the records are carved from the arena instead of the heap.
+		/// Reset the arena between the batches of an import
+		void bulk_load(const std::vector<RecordType> &records, common::database::RecordArena &arena)
+		{
+			common::database::RecordArena::Scope scope(arena);
+			bulk_load(records);
 		}
 
 		common::database::Uuid insert_without_id(const RecordType &record)
@@ -137,12 +274,17 @@ namespace drug_lib::dao
 
 		void remove_by_id(common::database::Uuid id) const
 		{
+			const std::string key = id.canonical_id();
 			common::database::Conditions removed_conditions;
 			removed_conditions.add_field_condition(
 				std::make_unique<common::database::Field<common::database::Uuid>>(
 					data::objects::shared::field_name::id, common::database::Uuid()), "=",
 				std::make_unique<common::database::Field<common::database::Uuid>>("", std::move(id)));
 			connect_->remove(table_name_, removed_conditions);
+			if (cache_)
+			{
+				cache_->invalidate(key);
+			}
 		}
 
 		[[nodiscard]] uint32_t count_all() const
@@ -150,17 +292,152 @@ namespace drug_lib::dao
 			return connect_->count(table_name_);
 		}
 
+		/// @brief Count of all records without scanning the table, e.g. for pagination
+		[[nodiscard]] uint32_t estimate_all() const
+		{
+			return connect_->estimate_count(table_name_);
+		}
+
 		void remove_all() const
 		{
 			connect_->truncate_table(table_name_);
+			if (cache_)
+			{
+				cache_->clear();
+			}
 		}
 
 		void delete_table() const
 		{
 			connect_->remove_table(table_name_);
+			if (cache_)
+			{
+				cache_->clear();
+			}
+		}
+
+		/// @brief Serve get_by_id from memory. Cache is shared by the copies of the handbook, writes through them
+		/// invalidate it, TTL bounds staleness of the changes made elsewhere
+		/// @warning Cached records share properties with the returned copies, so enable it only for handbooks
+		/// whose records aren't modified in place
+		void enable_cache(const CacheSettings &settings = {})
+		{
+			cache_ = std::make_shared<RecordCache<RecordType>>(settings);
+		}
+
+		void disable_cache()
+		{
+			cache_.reset();
+		}
+
+		/// @return Zeros if the cache is disabled
+		[[nodiscard]] CacheMetrics cache_metrics() const
+		{
+			return cache_ ? cache_->metrics() : CacheMetrics{};
 		}
 
 		RecordType get_by_id(common::database::Uuid id) const
+		{
+			if (!cache_)
+			{
+				return load_by_id(std::move(id));
+			}
+			const std::string key = id.canonical_id();
+			if (auto cached = cache_->get(key))
+			{
+				return std::move(*cached);
+			}
+			const auto version = cache_->version(key);
+			RecordType record = load_by_id(std::move(id));
+			cache_->put(key, record, version);
+			return record;
+		}
+
+		/// @brief Records of the ids in one round-trip, cached ones aren't requested
+		/// @return Records in the order of the ids
+		/// @throws common::database::exceptions::InvalidIdentifierException If any id is not found
+		std::vector<RecordType> get_by_ids(std::span<const common::database::Uuid> ids) const
+		{
+			struct Missing
+			{
+				std::vector<std::size_t> positions;
+				typename RecordCache<RecordType>::Version version = 0;
+			};
+			std::vector<std::optional<RecordType>> found(ids.size());
+			std::unordered_map<std::string, Missing> missing;
+			for (std::size_t i = 0; i < ids.size(); ++i)
+			{
+				const std::string key = ids[i].canonical_id();
+				if (cache_)
+				{
+					if (auto cached = cache_->get(key))
+					{
+						found[i] = std::move(cached);
+						continue;
+					}
+				}
+				auto [it, inserted] = missing.try_emplace(key);
+				if (inserted && cache_)
+				{
+					it->second.version = cache_->version(key);
+				}
+				it->second.positions.push_back(i);
+			}
+			if (!missing.empty())
+			{
+				std::vector<std::unique_ptr<common::database::FieldBase>> values;
+				values.reserve(missing.size());
+				for (const auto &key: missing | std::views::keys)
+				{
+					values.push_back(std::make_unique<common::database::Field<common::database::Uuid>>(
+						"", common::database::Uuid(key, false)));
+				}
+				common::database::Conditions select_conditions;
+				select_conditions.add_field_condition(
+					std::make_unique<common::database::Field<common::database::Uuid>>(
+						data::objects::shared::field_name::id, common::database::Uuid()), std::move(values));
+				for (RecordType &record: to_records(connect_->view(table_name_, select_conditions)))
+				{
+					const auto it = missing.find(key_of(record.get_id()));
+					if (it == missing.end())
+					{
+						continue;
+					}
+					if (cache_)
+					{
+						cache_->put(it->first, record, it->second.version);
+					}
+					for (const std::size_t position: it->second.positions)
+					{
+						found[position] = record;
+					}
+					missing.erase(it);
+				}
+			}
+			if (!missing.empty())
+			{
+				throw common::database::exceptions::InvalidIdentifierException(
+					"Record not found", common::database::errors::db_error_code::RECORD_NOT_FOUND);
+			}
+			std::vector<RecordType> records;
+			records.reserve(found.size());
+			for (auto &record: found)
+			{
+				records.push_back(std::move(*record));
+			}
+			return records;
+		}
+
+		/// @brief Same as get_by_ids, fields of the selected rows are carved from the arena instead of the heap
+		std::vector<RecordType> get_by_ids(std::span<const common::database::Uuid> ids,
+		                                   common::database::RecordArena &arena) const
+		{
+			common::database::RecordArena::Scope scope(arena);
+			return get_by_ids(ids);
+		}
+
+		/// @brief get_by_id bypassing the cache
+		RecordType load_by_id(common::database::Uuid id) const
 		{
 			common::database::Conditions select_conditions;
 			select_conditions.add_field_condition(
@@ -187,60 +464,240 @@ namespace drug_lib::dao
 		{
 			common::database::Conditions select_conditions;
 			select_conditions.add_pattern_condition(pattern);
-			auto res = connect_->view(table_name_, select_conditions);
+			return to_records(connect_->view(table_name_, select_conditions));
+		}
+
+		std::vector<RecordType> search_paged(
+			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
+		{
+			const auto query = search_query(pattern, page_limit, page_number);
+			return to_records(connect_->view(table_name_, query.conditions));
+		}
+
+		std::vector<RecordType> fuzzy_search_paged(
+			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
+		{
+			const auto query = fuzzy_search_query(pattern, page_limit, page_number);
+			return to_records(connect_->view(table_name_, query.conditions));
+		}
+
+		/// @brief Page of the keyset pagination
+		struct SeekPage
+		{
 			std::vector<RecordType> records;
-			records.reserve(res.size());
-			for (const auto &record: res)
+			/// Token of the next page, empty on the last page
+			std::string next_token;
+		};
+
+		/// @brief Exact matches by relevance following the page of the token. Unlike search_paged
+		/// skipped pages aren't scanned, so every page costs the same
+		/// @param page_token Token of the previous page, empty for the first page
+		/// @throws std::invalid_argument If the token is malformed
+		SeekPage search_after(const std::string &pattern, const uint16_t page_limit,
+		                      const std::string &page_token = {}) const
+		{
+			// One extra row tells if there is a next page
+			const auto query = search_after_query(pattern, page_limit + 1, page_token);
+			const auto rows = connect_->view(table_name_, query.conditions);
+			SeekPage page;
+			page.records = to_records(rows);
+			if (page.records.size() > page_limit)
 			{
-				RecordType tmp;
-				tmp.from_record(record);
-				records.push_back(std::move(tmp));
+				page.records.pop_back();
+				// Rank of the row is the trailing column
+				const auto &anchor = rows[page_limit - 1];
+				page.next_token = encode_page_token(page.records.back().get_id(),
+				                                    anchor->view(anchor->size() - 1));
 			}
-			return records;
+			return page;
 		}
 
-		std::vector<RecordType> search_paged(
+		/// @brief Exact and fuzzy pages in one round-trip
+		/// @return Exact matches, fuzzy matches
+		std::pair<std::vector<RecordType>, std::vector<RecordType>> search_paged_with_fuzzy(
 			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
 		{
-			common::database::Conditions select_conditions;
-			select_conditions.add_pattern_condition(pattern);
-			select_conditions.set_page_condition(common::database::PageCondition(page_limit).set_page_number(page_number));
-			auto res = connect_->view(table_name_, select_conditions);
-			std::vector<RecordType> records;
-			records.reserve(res.size());
-			for (const auto &record: res)
+			std::vector<common::database::interfaces::ViewQuery> queries;
+			queries.push_back(search_query(pattern, page_limit, page_number));
+			queries.push_back(fuzzy_search_query(pattern, page_limit, page_number));
+			auto res = connect_->view_batch(queries);
+			return {to_records(res[0]), to_records(res[1])};
+		}
+
+		/// @brief Record of ranked_search with its relevance
+		struct RankedRecord
+		{
+			RecordType record;
+			double relevance = 0;
+			/// Matched by full text search, not only similar
+			bool exact = false;
+		};
+
+		/// @brief Exact and similar matches in one query ordered by relevance, each record comes once.
+		/// Pages follow one order, so they neither overlap nor skip records. Records below the trigram similarity
+		/// threshold aren't similar, see RelevanceCondition
+		std::vector<RankedRecord> ranked_search(
+			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
+		{
+			const auto query = ranked_search_query(pattern, page_limit, page_number);
+			return to_ranked_records(connect_->view(table_name_, query.conditions));
+		}
+
+		/// @brief Query of ranked_search to send in a batch with other reads, see DbInterface::view_batch
+		[[nodiscard]] common::database::interfaces::ViewQuery ranked_search_query(
+			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
+		{
+			common::database::interfaces::ViewQuery query;
+			query.table_name = table_name_;
+			query.conditions.set_relevance_condition(common::database::RelevanceCondition(pattern));
+			// Ties of relevance are broken by id, so the order is the same for every page
+			query.conditions.add_order_by_condition(
+				common::database::OrderCondition(data::objects::shared::field_name::id));
+			query.conditions.set_page_condition(common::database::PageCondition(page_limit).set_page_number(page_number));
+			return query;
+		}
+
+		/// @brief Records of the rows selected with relevance condition, the last two columns are relevance
+		/// and exact match flag
+		[[nodiscard]] static std::vector<RankedRecord> to_ranked_records(
+			const std::vector<std::unique_ptr<common::database::ViewRecord>> &rows)
+		{
+			std::vector<RankedRecord> records;
+			if (rows.empty())
 			{
-				RecordType tmp;
-				tmp.from_record(record);
-				records.push_back(std::move(tmp));
+				return records;
+			}
+			const auto columns = rows.front()->columns();
+			const std::size_t record_columns = columns->size() - 2;
+			std::vector<std::string> names;
+			names.reserve(record_columns);
+			for (std::size_t i = 0; i < record_columns; ++i)
+			{
+				names.push_back(columns->name(i));
+			}
+			const data::objects::RowBinding binding = RecordType::bind(common::database::ColumnMap(std::move(names)));
+			records.reserve(rows.size());
+			for (const auto &row: rows)
+			{
+				RankedRecord ranked;
+				ranked.record.from_record(*row, binding);
+				const std::string_view relevance = row->view(record_columns);
+				std::from_chars(relevance.data(), relevance.data() + relevance.size(), ranked.relevance);
+				ranked.exact = row->view(record_columns + 1) == "t";
+				records.push_back(std::move(ranked));
 			}
 			return records;
 		}
 
-		std::vector<RecordType> fuzzy_search_paged(
+		/// @brief Query of search_paged to send in a batch with other reads, see DbInterface::view_batch
+		[[nodiscard]] common::database::interfaces::ViewQuery search_query(
 			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
 		{
-			common::database::Conditions select_conditions;
-			select_conditions.add_similarity_condition(pattern);
-			select_conditions.set_page_condition(common::database::PageCondition(page_limit).set_page_number(page_number));
-			auto res = connect_->view(table_name_, select_conditions);
+			common::database::interfaces::ViewQuery query;
+			query.table_name = table_name_;
+			query.conditions.add_pattern_condition(pattern);
+			query.conditions.set_page_condition(common::database::PageCondition(page_limit).set_page_number(page_number));
+			return query;
+		}
+
+		/// @brief Query of search_after to send in a batch with other reads, see DbInterface::view_batch
+		[[nodiscard]] common::database::interfaces::ViewQuery search_after_query(
+			const std::string &pattern, const uint32_t page_limit, const std::string &page_token = {}) const
+		{
+			common::database::interfaces::ViewQuery query;
+			query.table_name = table_name_;
+			query.conditions.add_pattern_condition(pattern);
+			query.conditions.set_pattern_ranking(true);
+			std::unique_ptr<common::database::FieldBase> after;
+			std::optional<double> after_rank;
+			if (!page_token.empty())
+			{
+				PageAnchor anchor = decode_page_token(page_token);
+				after = std::make_unique<common::database::Field<common::database::Uuid>>(
+					"", common::database::Uuid(std::move(anchor.key), false));
+				after_rank = anchor.rank;
+			}
+			query.conditions.set_seek_condition(common::database::SeekCondition(
+				std::make_unique<common::database::Field<common::database::Uuid>>(
+					data::objects::shared::field_name::id, common::database::Uuid()),
+				std::move(after), page_limit, after_rank));
+			return query;
+		}
+
+		/// @brief Query of fuzzy_search_paged to send in a batch with other reads, see DbInterface::view_batch
+		[[nodiscard]] common::database::interfaces::ViewQuery fuzzy_search_query(
+			const std::string &pattern, const uint16_t page_limit, const std::size_t page_number = 1) const
+		{
+			common::database::interfaces::ViewQuery query;
+			query.table_name = table_name_;
+			query.conditions.add_similarity_condition(pattern);
+			query.conditions.set_page_condition(common::database::PageCondition(page_limit).set_page_number(page_number));
+			return query;
+		}
+
+		[[nodiscard]] static std::vector<RecordType> to_records(
+			const std::vector<std::unique_ptr<common::database::ViewRecord>> &rows)
+		{
 			std::vector<RecordType> records;
-			records.reserve(res.size());
-			for (const auto &record: res)
+			if (rows.empty())
+			{
+				return records;
+			}
+			// Rows of one result share the columns, names are resolved by the first one
+			const data::objects::RowBinding binding = RecordType::bind(*rows.front()->columns());
+			records.reserve(rows.size());
+			for (const auto &row: rows)
 			{
 				RecordType tmp;
-				tmp.from_record(record);
+				tmp.from_record(*row, binding);
 				records.push_back(std::move(tmp));
 			}
 			return records;
 		}
 
+		/// @brief Walk over the records following conditions without loading the whole result.
+		/// Rows are fetched by batch_size, callback gets each record once
+		/// @warning Connection is busy during the walk, callback shouldn't use the same handbook outside a transaction
+		template <typename Callback>
+			requires std::invocable<Callback &, RecordType &&>
+		void for_each(const common::database::Conditions &conditions, Callback &&callback,
+		              const uint32_t batch_size = stream_batch_size) const
+		{
+			const auto cursor = connect_->stream(table_name_, conditions, batch_size);
+			std::optional<data::objects::RowBinding> binding;
+			while (const auto row = cursor->next_view())
+			{
+				if (!binding)
+				{
+					binding = RecordType::bind(*row->columns());
+				}
+				RecordType record;
+				record.from_record(*row, *binding);
+				callback(std::move(record));
+			}
+		}
+
+		/// @brief Walk over all records of the handbook, e.g. for exports and reindexing
+		template <typename Callback>
+			requires std::invocable<Callback &, RecordType &&>
+		void for_each(Callback &&callback, const uint32_t batch_size = stream_batch_size) const
+		{
+			for_each(common::database::Conditions{}, std::forward<Callback>(callback), batch_size);
+		}
+
 		virtual void set_connection(std::shared_ptr<common::database::interfaces::DbInterface> connect)
 		{
 			connect_ = std::move(connect);
 			this->setup();
 		}
 
+		/// @brief Switch to another connection without setup.
+		/// The connection must be set up before by a handbook of the same type
+		void bind_connection(std::shared_ptr<common::database::interfaces::DbInterface> connect)
+		{
+			connect_ = std::move(connect);
+		}
+
 		void drop_connection()
 		{
 			tear_down();
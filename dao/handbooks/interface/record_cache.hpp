@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace drug_lib::dao
+{
+    struct CacheSettings
+    {
+        /// Maximum number of records, split evenly between the shards
+        std::size_t capacity = 1 << 12;
+        /// Shards are locked independently, so concurrent sessions rarely wait for each other
+        std::size_t shards = 16;
+        /// Bounds staleness of the records changed by other processes
+        std::chrono::milliseconds ttl = std::chrono::seconds(60);
+    };
+
+    struct CacheMetrics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+        std::size_t size = 0;
+
+        [[nodiscard]] double hit_ratio() const
+        {
+            const uint64_t lookups = hits + misses;
+            return lookups == 0 ? 0. : static_cast<double>(hits) / static_cast<double>(lookups);
+        }
+    };
+
+    /// @brief Sharded LRU of decoded records with TTL. Operations lock only the shard of the key
+    template <typename Value>
+    class RecordCache final
+    {
+    public:
+        /// @brief Taken before reading the database. Put with an outdated version is dropped,
+        /// so a read racing with invalidation doesn't bring the stale record back
+        using Version = uint64_t;
+
+        /// @throws std::invalid_argument If capacity or shards count is 0
+        explicit RecordCache(const CacheSettings& settings)
+            : ttl_(settings.ttl)
+        {
+            if (settings.capacity == 0 || settings.shards == 0)
+            {
+                throw std::invalid_argument("Cache capacity and shards count must be positive.\t");
+            }
+            const std::size_t shards = std::min(settings.shards, settings.capacity);
+            shard_capacity_ = (settings.capacity + shards - 1) / shards;
+            shards_.reserve(shards);
+            for (std::size_t i = 0; i < shards; ++i)
+            {
+                shards_.push_back(std::make_unique<Shard>());
+            }
+        }
+
+        /// @return Copy of the cached value, nullopt if it is missing or expired
+        [[nodiscard]] std::optional<Value> get(const std::string& key)
+        {
+            Shard& shard = shard_of(key);
+            std::lock_guard lock(shard.mutex);
+            const auto it = shard.index.find(key);
+            if (it == shard.index.end())
+            {
+                ++shard.misses;
+                return std::nullopt;
+            }
+            if (it->second->expires_at <= std::chrono::steady_clock::now())
+            {
+                shard.entries.erase(it->second);
+                shard.index.erase(it);
+                ++shard.misses;
+                return std::nullopt;
+            }
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            ++shard.hits;
+            return it->second->value;
+        }
+
+        [[nodiscard]] Version version(const std::string& key) const
+        {
+            Shard& shard = shard_of(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.version;
+        }
+
+        /// @param version Version of the key taken before the value was read
+        void put(const std::string& key, Value value, const Version version)
+        {
+            Shard& shard = shard_of(key);
+            std::lock_guard lock(shard.mutex);
+            if (shard.version != version)
+            {
+                return;
+            }
+            const auto expires_at = std::chrono::steady_clock::now() + ttl_;
+            if (const auto it = shard.index.find(key); it != shard.index.end())
+            {
+                it->second->value = std::move(value);
+                it->second->expires_at = expires_at;
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                return;
+            }
+            shard.entries.push_front({key, std::move(value), expires_at});
+            shard.index.emplace(key, shard.entries.begin());
+            if (shard.entries.size() > shard_capacity_)
+            {
+                shard.index.erase(shard.entries.back().key);
+                shard.entries.pop_back();
+                ++shard.evictions;
+            }
+        }
+
+        void invalidate(const std::string& key)
+        {
+            Shard& shard = shard_of(key);
+            std::lock_guard lock(shard.mutex);
+            ++shard.version;
+            if (const auto it = shard.index.find(key); it != shard.index.end())
+            {
+                shard.entries.erase(it->second);
+                shard.index.erase(it);
+                ++shard.invalidations;
+            }
+        }
+
+        void clear()
+        {
+            for (const auto& shard : shards_)
+            {
+                std::lock_guard lock(shard->mutex);
+                ++shard->version;
+                shard->invalidations += shard->entries.size();
+                shard->index.clear();
+                shard->entries.clear();
+            }
+        }
+
+        [[nodiscard]] CacheMetrics metrics() const
+        {
+            CacheMetrics metrics;
+            for (const auto& shard : shards_)
+            {
+                std::lock_guard lock(shard->mutex);
+                metrics.hits += shard->hits;
+                metrics.misses += shard->misses;
+                metrics.evictions += shard->evictions;
+                metrics.invalidations += shard->invalidations;
+                metrics.size += shard->entries.size();
+            }
+            return metrics;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            Value value;
+            std::chrono::steady_clock::time_point expires_at;
+        };
+
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            // Most recently used first
+            std::list<Entry> entries;
+            std::unordered_map<std::string, typename std::list<Entry>::iterator> index;
+            Version version = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t invalidations = 0;
+        };
+
+        [[nodiscard]] Shard& shard_of(const std::string& key) const
+        {
+            return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+        }
+
+        std::chrono::milliseconds ttl_;
+        std::size_t shard_capacity_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+}
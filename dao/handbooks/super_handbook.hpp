@@ -18,6 +18,11 @@ namespace drug_lib::dao
             return patients_;
         }
 
+        [[nodiscard]] const PatientsHandbook& patients() const
+        {
+            return patients_;
+        }
+
         void set_patients(PatientsHandbook patients)
         {
             patients_ = std::move(patients);
@@ -28,6 +33,11 @@ namespace drug_lib::dao
             return medicaments_;
         }
 
+        [[nodiscard]] const MedicamentsHandbook& medicaments() const
+        {
+            return medicaments_;
+        }
+
         void set_medicaments(MedicamentsHandbook medicaments)
         {
             medicaments_ = std::move(medicaments);
@@ -38,6 +48,11 @@ namespace drug_lib::dao
             return organizations_;
         }
 
+        [[nodiscard]] const OrganizationsHandbook& organizations() const
+        {
+            return organizations_;
+        }
+
         void set_organizations(OrganizationsHandbook organizations)
         {
             organizations_ = std::move(organizations);
@@ -48,12 +63,39 @@ namespace drug_lib::dao
             return diseases_;
         }
 
+        [[nodiscard]] const DiseaseHandbook& diseases() const
+        {
+            return diseases_;
+        }
+
         void set_diseases(DiseaseHandbook diseases)
         {
             diseases_ = std::move(diseases);
         }
 
+        /// @brief Cache get_by_id of the reference handbooks(medicaments, diseases), which are read far more often
+        /// than changed. Copies made by bind share the caches
+        void enable_reference_cache(const CacheSettings& settings = {})
+        {
+            medicaments_.enable_cache(settings);
+            diseases_.enable_cache(settings);
+        }
+
         void direct_establish(const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
+        {
+            prepare(connect);
+            owns_connection_ = true;
+        }
+
+        void establish_from_pool(common::database::creational::DbInterfacePool& pool)
+        {
+            shared_connect = pool.acquire_db_interface();
+            prepare(shared_connect);
+            used_pool = pool;
+        }
+
+        /// @brief Setup handbooks on the connection(tables, indexes, fields of the client) without owning it
+        void prepare(const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
         {
             patients_.set_connection(connect);
             medicaments_.set_connection(connect);
@@ -61,24 +103,50 @@ namespace drug_lib::dao
             diseases_.set_connection(connect);
         }
 
-        void establish_from_pool(common::database::creational::DbInterfacePool& pool)
+        /// @brief Copy of the handbooks working on another connection without setup.
+        /// The connection must be prepared before, see prepare_connection
+        [[nodiscard]] SuperHandbook bind(const std::shared_ptr<common::database::interfaces::DbInterface>& connect) const
         {
-            shared_connect = pool.acquire_db_interface();
-            direct_establish(shared_connect);
-            used_pool = pool;
+            SuperHandbook bound(*this);
+            bound.patients_.bind_connection(connect);
+            bound.medicaments_.bind_connection(connect);
+            bound.organizations_.bind_connection(connect);
+            bound.diseases_.bind_connection(connect);
+            return bound;
         }
 
+        /// @brief Prepare a new connection for all handbooks, e.g. as initializer of the pool
+        static void prepare_connection(const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
+        {
+            SuperHandbook().prepare(connect);
+        }
+
+        SuperHandbook() = default;
+
+        /// @brief Copy shares the connection, but doesn't own it
+        SuperHandbook(const SuperHandbook& other)
+            : patients_(other.patients_),
+              medicaments_(other.medicaments_),
+              organizations_(other.organizations_),
+              diseases_(other.diseases_)
+        {
+        }
+
+        SuperHandbook& operator=(const SuperHandbook&) = delete;
+
         ~SuperHandbook()
         {
-            patients_.drop_connection();
-            medicaments_.drop_connection();
-            organizations_.drop_connection();
-            diseases_.drop_connection();
             if (used_pool)
             {
                 used_pool->get().release_db_interface(std::move(shared_connect));
             }
-            std::cout << "Destroying SuperHandbook" << std::endl;
+            else if (owns_connection_)
+            {
+                patients_.drop_connection();
+                medicaments_.drop_connection();
+                organizations_.drop_connection();
+                diseases_.drop_connection();
+            }
         }
 
     private:
@@ -88,5 +156,6 @@ namespace drug_lib::dao
         DiseaseHandbook diseases_;
         std::optional<std::reference_wrapper<common::database::creational::DbInterfacePool>> used_pool;
         std::shared_ptr<common::database::interfaces::DbInterface> shared_connect;
+        bool owns_connection_ = false;
     };
 }
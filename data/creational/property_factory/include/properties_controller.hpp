@@ -25,98 +25,32 @@ namespace drug_lib::data
             return std::make_shared<T>(std::forward<Args>(args)...);
         }
 
+        /// @brief Property registered by the name, see registered_properties of the object kinds
+        /// @throws std::invalid_argument If the property name is unknown
         static std::shared_ptr<DataProperty> create(const std::string& property_name,
                                                     const Json::Value& property_value)
         {
-            // Meds
-            if (property_name == objects::medicaments::properties::prescription)
+            if (const auto create_property = Registry::find(property_name))
             {
-                return std::make_shared<objects::medicaments::Prescription>(property_value);
+                return create_property(property_value);
             }
-            if (property_name == objects::medicaments::properties::active_ingredients)
-            {
-                return std::make_shared<objects::medicaments::ActiveIngredients>(property_value);
-            }
-            if (property_name == objects::medicaments::properties::inactive_ingredients)
-            {
-                return std::make_shared<objects::medicaments::InactiveIngredients>(property_value);
-            }
-            if (property_name == objects::medicaments::properties::dosage_form)
-            {
-                return std::make_shared<objects::medicaments::DosageForm>(property_value);
-            }
-            if (property_name == objects::medicaments::properties::side_effects)
-            {
-                return std::make_shared<objects::medicaments::SideEffects>(property_value);
-            }
-            if (property_name == objects::medicaments::properties::strength)
-            {
-                return std::make_shared<objects::medicaments::Strength>(property_value);
-            }
-
-            // Diseases
-            if (property_name == objects::diseases::properties::symptoms)
-            {
-                return std::make_shared<objects::diseases::Symptoms>(property_value);
-            }
-            if (property_name == objects::diseases::properties::curative_drugs)
-            {
-                return std::make_shared<objects::diseases::CurativeDrugs>(property_value);
-            }
-            if (property_name == objects::diseases::properties::affected_age_groups)
-            {
-                return std::make_shared<objects::diseases::AffectedAgeGroups>(property_value);
-            }
-            if (property_name == objects::diseases::properties::complications)
-            {
-                return std::make_shared<objects::diseases::Complications>(property_value);
-            }
-            if (property_name == objects::diseases::properties::risk_factors)
-            {
-                return std::make_shared<objects::diseases::RiskFactors>(property_value);
-            }
-
-            // Orgs
-            if (property_name == objects::organizations::properties::license)
-            {
-                return std::make_shared<objects::organizations::License>(property_value);
-            }
-
-            // Patients
-            if (property_name == objects::patients::properties::current_diseases)
-            {
-                return std::make_shared<objects::patients::CurrentDiseases>(property_value);
-            }
-            if (property_name == objects::patients::properties::current_medicaments)
-            {
-                return std::make_shared<objects::patients::CurrentMedicaments>(property_value);
-            }
-            if (property_name == objects::patients::properties::allergies)
-            {
-                return std::make_shared<objects::patients::Allergies>(property_value);
-            }
-            if (property_name == objects::patients::properties::blood_type)
-            {
-                return std::make_shared<objects::patients::BloodType>(property_value);
-            }
-            if (property_name == objects::patients::properties::insurance)
-            {
-                return std::make_shared<objects::patients::Insurance>(property_value);
-            }
-            if (property_name == objects::patients::properties::medical_history)
-            {
-                return std::make_shared<objects::patients::MedicalHistory>(property_value);
-            }
-            if (property_name == objects::patients::properties::vaccines)
-            {
-                return std::make_shared<objects::patients::Vaccines>(property_value);
-            }
-
-
             throw std::invalid_argument("Property '" + property_name + "' not found");
         }
+
+    private:
+        using Registry = PropertyRegistry<
+            objects::medicaments::registered_properties,
+            objects::diseases::registered_properties,
+            objects::organizations::registered_properties,
+            objects::patients::registered_properties>;
     };
 
+    inline std::shared_ptr<DataProperty> PropertyCollection::decode(const std::string& property_name,
+                                                                   const std::string_view raw)
+    {
+        return PropertyFactory::create(property_name, detail::parse_json(raw));
+    }
+
     namespace objects
     {
         class PropertiesHolder
@@ -141,17 +75,10 @@ namespace drug_lib::data
                 }
             }
 
-            void create_collection(const std::string& field)
+            /// @brief Keep the raw JSON of the properties, they are decoded on access
+            void create_collection(std::string field)
             {
-                const Json::CharReaderBuilder builder;
-                Json::Value values;
-                std::istringstream s(field);
-                std::string errors;
-                parseFromStream(builder, s, &values, &errors);
-                for (Json::Value::const_iterator it = values.begin(); it != values.end(); ++it)
-                {
-                    collection_.add_property(PropertyFactory::create(it.name(), *it));
-                }
+                collection_.set_raw(std::move(field));
             }
 
         public:
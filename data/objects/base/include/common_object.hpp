@@ -49,6 +49,28 @@ namespace drug_lib::data
 				return result;
 			}
 
+			/// @brief Write the object as to_json does, without building the value tree
+			void write_json(JsonWriter &writer) const
+			{
+				writer.begin_object();
+				write_members(writer);
+				writer.end_object();
+			}
+
+			/// @brief Write the members of the object into the object opened by the caller
+			virtual void write_members(JsonWriter &writer) const
+			{
+				writer.member(shared::field_name::id, id_.get_id());
+			}
+
+			[[nodiscard]] std::string to_json_text() const
+			{
+				std::string result;
+				JsonWriter writer(result);
+				write_json(writer);
+				return result;
+			}
+
 			virtual void from_json(const Json::Value &val)
 			{
 				if (val.isMember(shared::field_name::id))
@@ -88,12 +110,7 @@ namespace drug_lib::data
 
 	[[nodiscard]] inline std::unique_ptr<common::database::Field<Json::Value>> PropertyCollection::make_properties_field() const noexcept
 	{
-		Json::Value result;
-		for (const auto &[name, property]: m_data)
-		{
-			result[name] = property->get_info();
-		}
 		return std::make_unique<common::database::Field<Json::Value>>(
-			objects::shared::field_name::properties, result);
+			objects::shared::field_name::properties, get_collection_info());
 	}
 }
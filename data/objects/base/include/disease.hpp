@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "common_object.hpp"
+#include "object_schema.hpp"
 #include "properties_controller.hpp"
 namespace drug_lib::data::objects
 {
@@ -16,83 +17,64 @@ namespace drug_lib::data::objects
     {
     public:
 
+        /// @brief Columns of the table, properties column is kept by PropertiesHolder
+        static constexpr auto schema()
+        {
+            return ObjectSchema(
+                make_column(shared::field_name::id, &Disease::id_, ColumnRole::KEY),
+                make_column(disease::field_name::name, &Disease::name_),
+                make_column(disease::field_name::type, &Disease::type_),
+                make_column(disease::field_name::is_infectious, &Disease::is_infectious_));
+        }
+
         [[nodiscard]] common::database::Record to_record() const override
         {
-            common::database::Record record;
-            record.push_back(std::make_unique<common::database::Field<common::database::Uuid>>(shared::field_name::id, id_));
-            record.push_back(std::make_unique<common::database::Field<std::string>>(disease::field_name::name, name_));
-            record.push_back(std::make_unique<common::database::Field<std::string>>(disease::field_name::type, type_));
-            record.push_back(
-                std::make_unique<common::database::Field<bool>>(disease::field_name::is_infectious, is_infectious_));
+            static constexpr auto columns = schema();
+            common::database::Record record = columns.to_record(*this, 1);
             record.push_back(collection_.make_properties_field());
             return record;
         }
 
         void from_record(const common::database::Record& record) override
         {
-            for (const auto& field : record.fields())
+            static constexpr auto columns = schema();
+            for (std::size_t i = 0; i < record.size(); ++i)
             {
-                if (const auto& field_name = field->get_name();
-                    field_name == shared::field_name::id)
-                {
-                    id_ = field->as<common::database::Uuid>();
-                }
-                else if (field_name == disease::field_name::name)
-                {
-                    name_ = field->as<std::string>();
-                }
-                else if (field_name == disease::field_name::type)
-                {
-                    type_ = field->as<std::string>();
-                }
-                else if (field_name == disease::field_name::is_infectious)
+                const auto& field = record[i];
+                if (columns.assign(*this, i, field->get_name(), *field))
                 {
-                    is_infectious_ = field->as<bool>();
+                    continue;
                 }
-                else if (field_name == shared::field_name::properties)
+                if (field->get_name() != shared::field_name::properties)
                 {
-                    create_collection(field);
-                }
-                else
-                {
-                    throw std::invalid_argument("Unknown field name: " + field_name);
+                    throw std::invalid_argument("Unknown field name: " + field->get_name());
                 }
+                create_collection(field);
             }
         }
 
-        void from_record(const std::unique_ptr<common::database::ViewRecord>& viewed) override
+        /// @brief Ordinals of the object columns in the result, resolved once for all its rows
+        [[nodiscard]] static RowBinding bind(const common::database::ColumnMap& columns)
+        {
+            static constexpr auto schema_columns = schema();
+            return schema_columns.bind(columns, shared::field_name::properties);
+        }
+
+        void from_record(const common::database::ViewRecord& viewed, const RowBinding& binding)
         {
-            for (std::size_t i = 0; i < viewed->size(); i++)
+            static constexpr auto columns = schema();
+            columns.assign_row(*this, viewed, binding);
+            if (binding.extra != common::database::ColumnMap::npos)
             {
-                if (const auto& field_name = viewed->name(i);
-                    field_name == shared::field_name::id)
-                {
-                    id_ = viewed->extract(i);
-                }
-                else if (field_name == disease::field_name::name)
-                {
-                    name_ = viewed->extract(i);
-                }
-                else if (field_name == disease::field_name::type)
-                {
-                    type_ = viewed->extract(i);
-                }
-                else if (field_name == disease::field_name::is_infectious)
-                {
-                    //WARNING this is wierd stuff
-                    is_infectious_ = viewed->extract(i) == "t";
-                }
-                else if (field_name == shared::field_name::properties)
-                {
-                    create_collection(viewed->extract(i));
-                }
-                else
-                {
-                    throw std::invalid_argument("Unknown field name: " + field_name);
-                }
+                create_collection(viewed.extract(binding.extra));
             }
         }
 
+        void from_record(const std::unique_ptr<common::database::ViewRecord>& viewed) override
+        {
+            from_record(*viewed, bind(*viewed->columns()));
+        }
+
         [[nodiscard]] [[nodiscard]] Json::Value to_json() const  override
         {
             Json::Value result = ObjectBase::to_json();
@@ -103,6 +85,16 @@ namespace drug_lib::data::objects
             return result;
         }
 
+        void write_members(JsonWriter& writer) const override
+        {
+            ObjectBase::write_members(writer);
+            writer.member(disease::field_name::name, name_);
+            writer.member(disease::field_name::type, type_);
+            writer.member(disease::field_name::is_infectious, is_infectious_);
+            writer.key(shared::field_name::properties);
+            collection_.write_json(writer);
+        }
+
         void from_json(const Json::Value& val) override
         {
             ObjectBase::from_json(val);
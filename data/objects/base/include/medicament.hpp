@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "common_object.hpp"
+#include "object_schema.hpp"
 #include "properties_controller.hpp"
 
 namespace drug_lib::data::objects
@@ -103,114 +104,67 @@ namespace drug_lib::data::objects
 			atc_code_ = atc_code;
 		}
 
-		// Метод для преобразования медикамента в запись (Record)
+		/// @brief Columns of the table, properties column is kept by PropertiesHolder
+		static constexpr auto schema()
+		{
+			return ObjectSchema(
+				make_column(shared::field_name::id, &Medicament::id_, ColumnRole::KEY),
+				make_column(medicament::field_name::name, &Medicament::name_),
+				make_column(medicament::field_name::type, &Medicament::type_),
+				make_column(medicament::field_name::requires_prescription, &Medicament::requires_prescription_),
+				make_column(medicament::field_name::approval_status, &Medicament::approval_status_),
+				make_column(medicament::field_name::approval_number, &Medicament::approval_number_),
+				make_column(medicament::field_name::atc_code, &Medicament::atc_code_));
+		}
+
 		[[nodiscard]] common::database::Record to_record() const override
 		{
-			common::database::Record record;
-			record.push_back(std::make_unique<common::database::Field<common::database::Uuid>>(shared::field_name::id, id_));
-			record.push_back(std::make_unique<common::database::Field<std::string>>(medicament::field_name::name, name_));
-			record.push_back(std::make_unique<common::database::Field<std::string>>(medicament::field_name::type, type_));
-			record.push_back(std::make_unique<common::database::Field<bool>>(
-				medicament::field_name::requires_prescription,
-				requires_prescription_));
-			record.push_back(
-				std::make_unique<common::database::Field<std::string>>(medicament::field_name::approval_status, approval_status_));
-			record.push_back(
-				std::make_unique<common::database::Field<std::string>>(medicament::field_name::approval_number, approval_number_));
-			record.push_back(std::make_unique<common::database::Field<std::string>>(medicament::field_name::atc_code, atc_code_));
+			static constexpr auto columns = schema();
+			common::database::Record record = columns.to_record(*this, 1);
 			record.push_back(collection_.make_properties_field());
 			return record;
 		}
 
-		// Метод для обновления данных медикамента на основе записи
 		void from_record(const common::database::Record &record) override
 		{
-			for (const auto &field: record.fields())
+			static constexpr auto columns = schema();
+			for (std::size_t i = 0; i < record.size(); ++i)
 			{
-				if (const auto &field_name = field->get_name();
-					field_name == shared::field_name::id)
-				{
-					id_ = field->as<common::database::Uuid>();
-				}
-				else if (field_name == medicament::field_name::name)
-				{
-					name_ = field->as<std::string>();
-				}
-				else if (field_name == medicament::field_name::type)
-				{
-					type_ = field->as<std::string>();
-				}
-				else if (field_name == medicament::field_name::requires_prescription)
+				const auto &field = record[i];
+				if (columns.assign(*this, i, field->get_name(), *field))
 				{
-					requires_prescription_ = field->as<bool>();
+					continue;
 				}
-				else if (field_name == medicament::field_name::approval_number)
+				if (field->get_name() != shared::field_name::properties)
 				{
-					approval_number_ = field->as<std::string>();
-				}
-				else if (field_name == medicament::field_name::approval_status)
-				{
-					approval_status_ = field->as<std::string>();
-				}
-				else if (field_name == medicament::field_name::atc_code)
-				{
-					atc_code_ = field->as<std::string>();
-				}
-				else if (field_name == shared::field_name::properties)
-				{
-					create_collection(field);
-				}
-				else
-				{
-					throw std::invalid_argument("Unknown field name: " + field_name);
+					throw std::invalid_argument("Unknown field name: " + field->get_name());
 				}
+				create_collection(field);
 			}
 		}
 
-		void from_record(const std::unique_ptr<common::database::ViewRecord> &viewed) override
+		/// @brief Ordinals of the object columns in the result, resolved once for all its rows
+		[[nodiscard]] static RowBinding bind(const common::database::ColumnMap &columns)
 		{
-			for (std::size_t i = 0; i < viewed->size(); i++)
+			static constexpr auto schema_columns = schema();
+			return schema_columns.bind(columns, shared::field_name::properties);
+		}
+
+		void from_record(const common::database::ViewRecord &viewed, const RowBinding &binding)
+		{
+			static constexpr auto columns = schema();
+			columns.assign_row(*this, viewed, binding);
+			if (binding.extra != common::database::ColumnMap::npos)
 			{
-				if (const auto &field_name = viewed->name(i);
-					field_name == shared::field_name::id)
-				{
-					id_ = viewed->extract(i);
-				}
-				else if (field_name == medicament::field_name::name)
-				{
-					name_ = viewed->extract(i);
-				}
-				else if (field_name == medicament::field_name::type)
-				{
-					type_ = viewed->extract(i);
-				}
-				else if (field_name == medicament::field_name::requires_prescription)
-				{
-					requires_prescription_ = viewed->view(i) == "t";
-				}
-				else if (field_name == medicament::field_name::approval_number)
-				{
-					approval_number_ = viewed->extract(i);
-				}
-				else if (field_name == medicament::field_name::approval_status)
-				{
-					approval_status_ = viewed->extract(i);
-				}
-				else if (field_name == medicament::field_name::atc_code)
-				{
-					atc_code_ = viewed->extract(i);
-				}
-				else if (field_name == shared::field_name::properties)
-				{
-					create_collection(viewed->extract(i));
-				}
-				else
-				{
-					throw std::invalid_argument("Unknown field name: " + field_name);
-				}
+				create_collection(viewed.extract(binding.extra));
 			}
 		}
 
+		void from_record(const std::unique_ptr<common::database::ViewRecord> &viewed) override
+		{
+			from_record(*viewed, bind(*viewed->columns()));
+		}
+
 		[[nodiscard]] Json::Value to_json() const override
 		{
 			Json::Value result = ObjectBase::to_json();
@@ -224,6 +178,19 @@ namespace drug_lib::data::objects
 			return result;
 		}
 
+		void write_members(JsonWriter &writer) const override
+		{
+			ObjectBase::write_members(writer);
+			writer.member(medicament::field_name::name, name_);
+			writer.member(medicament::field_name::type, type_);
+			writer.member(medicament::field_name::requires_prescription, requires_prescription_);
+			writer.member(medicament::field_name::approval_number, approval_number_);
+			writer.member(medicament::field_name::approval_status, approval_status_);
+			writer.member(medicament::field_name::atc_code, atc_code_);
+			writer.key(shared::field_name::properties);
+			collection_.write_json(writer);
+		}
+
 		void from_json(const Json::Value &val) override
 		{
 			ObjectBase::from_json(val);
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "db_field.hpp"
+#include "db_record.hpp"
+
+namespace drug_lib::data::objects
+{
+	/// @brief Conversion of a member to its column. DbType is the type of the field in Record,
+	/// from_text takes the value as the backend prints it in ViewRecord
+	template <typename T>
+	struct ColumnCodec;
+
+	template <>
+	struct ColumnCodec<std::string>
+	{
+		using DbType = std::string;
+
+		static const std::string &to_db(const std::string &value)
+		{
+			return value;
+		}
+
+		static void from_db(std::string &value, const common::database::FieldBase &field)
+		{
+			value = field.as<std::string>();
+		}
+
+		static void from_text(std::string &value, const std::string_view text)
+		{
+			value.assign(text);
+		}
+	};
+
+	template <>
+	struct ColumnCodec<bool>
+	{
+		using DbType = bool;
+
+		static bool to_db(const bool value)
+		{
+			return value;
+		}
+
+		static void from_db(bool &value, const common::database::FieldBase &field)
+		{
+			value = field.as<bool>();
+		}
+
+		static void from_text(bool &value, const std::string_view text)
+		{
+			value = text == "t";
+		}
+	};
+
+	template <>
+	struct ColumnCodec<common::database::Uuid>
+	{
+		using DbType = common::database::Uuid;
+
+		static const common::database::Uuid &to_db(const common::database::Uuid &value)
+		{
+			return value;
+		}
+
+		static void from_db(common::database::Uuid &value, const common::database::FieldBase &field)
+		{
+			value = field.as<common::database::Uuid>();
+		}
+
+		/// @brief Keeps primary flag of the member
+		static void from_text(common::database::Uuid &value, const std::string_view text)
+		{
+			value = std::string(text);
+		}
+	};
+
+	/// @brief Date is stored as timestamp of its midnight
+	template <>
+	struct ColumnCodec<std::chrono::year_month_day>
+	{
+		using DbType = std::chrono::system_clock::time_point;
+
+		static DbType to_db(const std::chrono::year_month_day &value)
+		{
+			return std::chrono::sys_days{value};
+		}
+
+		static void from_db(std::chrono::year_month_day &value, const common::database::FieldBase &field)
+		{
+			value = std::chrono::floor<std::chrono::days>(field.as<DbType>());
+		}
+
+		/// @param text "YYYY-MM-DD[ HH:MM:SS]" in local time, as timestamps are written
+		static void from_text(std::chrono::year_month_day &value, const std::string_view text)
+		{
+			std::tm tm = {};
+			std::size_t position = 0;
+			auto read_number = [&](int &number, const std::size_t digits)
+			{
+				if (position + digits > text.size() ||
+					std::from_chars(text.data() + position, text.data() + position + digits, number).ptr !=
+					text.data() + position + digits)
+				{
+					throw std::runtime_error("Failed to parse date: " + std::string(text));
+				}
+				// Skip the separator
+				position += digits + 1;
+			};
+			read_number(tm.tm_year, 4);
+			read_number(tm.tm_mon, 2);
+			read_number(tm.tm_mday, 2);
+			if (position < text.size())
+			{
+				read_number(tm.tm_hour, 2);
+				read_number(tm.tm_min, 2);
+				read_number(tm.tm_sec, 2);
+			}
+			tm.tm_year -= 1900;
+			tm.tm_mon -= 1;
+			tm.tm_isdst = -1;
+			value = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::from_time_t(std::mktime(&tm)));
+		}
+	};
+
+	/// @brief Ordinals of the schema columns in a result set, resolved once per result by ObjectSchema::bind
+	struct RowBinding
+	{
+		/// Row ordinal per schema column, npos for columns missing from the result
+		std::vector<std::size_t> ordinals;
+		/// Row ordinal of the column handled by the object itself
+		std::size_t extra = common::database::ColumnMap::npos;
+	};
+
+	enum class ColumnRole
+	{
+		KEY,
+		VALUE
+	};
+
+	/// @brief Column of the object table bound to the member storing it
+	template <typename Owner, typename T>
+	struct ObjectColumn
+	{
+		using Codec = ColumnCodec<T>;
+
+		std::string_view name;
+		T Owner::*member;
+		ColumnRole role;
+
+		template <typename Object>
+		[[nodiscard]] std::unique_ptr<common::database::FieldBase> make_field(const Object &object) const
+		{
+			return std::make_unique<common::database::Field<typename Codec::DbType>>(
+				std::string(name), Codec::to_db(object.*member));
+		}
+
+		/// @return Field declaring the column for the table creation
+		[[nodiscard]] std::shared_ptr<common::database::FieldBase> make_declaration() const
+		{
+			return common::database::make_field_shared<typename Codec::DbType>(std::string(name));
+		}
+	};
+
+	template <typename Owner, typename T>
+	constexpr ObjectColumn<Owner, T> make_column(const std::string_view name, T Owner::*member,
+	                                             const ColumnRole role = ColumnRole::VALUE)
+	{
+		return {name, member, role};
+	}
+
+	/// @brief Compile-time description of the object table: column names, member types and their sql types.
+	/// Conversions to and from records are unrolled over the columns, no runtime field lists are kept.
+	/// Columns which aren't plain members (e.g. properties) are handled by the object itself
+	template <typename... Columns>
+	class ObjectSchema
+	{
+	public:
+		static constexpr std::size_t size = sizeof...(Columns);
+
+		constexpr explicit ObjectSchema(Columns... columns)
+			: columns_(columns...)
+		{
+		}
+
+		[[nodiscard]] constexpr std::array<std::string_view, size> names() const
+		{
+			return std::apply([](const auto &... column)
+			{
+				return std::array<std::string_view, size>{column.name...};
+			}, columns_);
+		}
+
+		/// @param extra_columns Count of the columns the caller appends after the schema ones
+		template <typename Object>
+		[[nodiscard]] common::database::Record to_record(const Object &object, const std::size_t extra_columns = 0) const
+		{
+			common::database::Record record;
+			record.reserve(size + extra_columns);
+			std::apply([&](const auto &... column)
+			{
+				(record.push_back(column.make_field(object)), ...);
+			}, columns_);
+			return record;
+		}
+
+		/// @param position Ordinal of the field in the row, the column at the same ordinal is checked first
+		/// @return False if there is no column with the name
+		template <typename Object>
+		bool assign(Object &object, const std::size_t position, const std::string_view name,
+		            const common::database::FieldBase &field) const
+		{
+			return visit(position, name, [&](const auto &column)
+			{
+				using Codec = typename std::remove_cvref_t<decltype(column)>::Codec;
+				Codec::from_db(object.*column.member, field);
+			});
+		}
+
+		/// @param extra_name Column which isn't in the schema but is handled by the object
+		/// @throws std::invalid_argument If the result has a column which is neither in the schema nor the extra one
+		[[nodiscard]] RowBinding bind(const common::database::ColumnMap &columns, const std::string_view extra_name) const
+		{
+			RowBinding binding;
+			binding.ordinals.reserve(size);
+			std::apply([&](const auto &... column)
+			{
+				(binding.ordinals.push_back(columns.find(column.name)), ...);
+			}, columns_);
+			binding.extra = columns.find(extra_name);
+			const std::size_t bound = std::ranges::count_if(binding.ordinals, [](const std::size_t ordinal)
+			{
+				return ordinal != common::database::ColumnMap::npos;
+			}) + (binding.extra != common::database::ColumnMap::npos ? 1 : 0);
+			if (bound != columns.size())
+			{
+				const auto known = names();
+				for (std::size_t i = 0; i < columns.size(); ++i)
+				{
+					if (columns.name(i) != extra_name && std::ranges::find(known, columns.name(i)) == known.end())
+					{
+						throw std::invalid_argument("Unknown field name: " + columns.name(i));
+					}
+				}
+			}
+			return binding;
+		}
+
+		/// @brief Assign the members from the row by the ordinals of the binding, no names are compared
+		template <typename Object>
+		void assign_row(Object &object, const common::database::ViewRecord &row, const RowBinding &binding) const
+		{
+			std::apply([&](const auto &... column)
+			{
+				std::size_t index = 0;
+				(assign_text(object, column, row, binding.ordinals[index++]), ...);
+			}, columns_);
+		}
+
+		/// @brief Fill declarations of the key and value columns, in the schema order
+		void declare(std::vector<std::shared_ptr<common::database::FieldBase>> &key_fields,
+		             std::vector<std::shared_ptr<common::database::FieldBase>> &value_fields) const
+		{
+			std::apply([&](const auto &... column)
+			{
+				((column.role == ColumnRole::KEY ? key_fields : value_fields).push_back(column.make_declaration()), ...);
+			}, columns_);
+		}
+
+	private:
+		std::tuple<Columns...> columns_;
+
+		template <typename Object, typename Column>
+		static void assign_text(Object &object, const Column &column, const common::database::ViewRecord &row,
+		                        const std::size_t ordinal)
+		{
+			if (ordinal != common::database::ColumnMap::npos)
+			{
+				Column::Codec::from_text(object.*column.member, row.view(ordinal));
+			}
+		}
+
+		template <typename Func>
+		bool visit(const std::size_t position, const std::string_view name, Func &&func) const
+		{
+			return std::apply([&](const auto &... column)
+			{
+				// Tables are created in the schema order, so the column at the same ordinal matches almost always
+				std::size_t index = 0;
+				bool found = false;
+				((found = found || (index++ == position && column.name == name && (func(column), true))), ...);
+				if (!found)
+				{
+					((found = found || (column.name == name && (func(column), true))), ...);
+				}
+				return found;
+			}, columns_);
+		}
+	};
+}
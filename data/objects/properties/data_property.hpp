@@ -1,8 +1,14 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 
 #include "db_field.hpp"
+#include "json_writer.hpp"
 
 namespace drug_lib::data
 {
@@ -15,6 +21,12 @@ namespace drug_lib::data
 
         virtual void set_info(const Json::Value& property) = 0;
 
+        /// @brief Write the value of the property, by default through get_info
+        virtual void write_json(JsonWriter& writer) const
+        {
+            writer.value(get_info());
+        }
+
         [[nodiscard]] virtual std::string get_name() const = 0;
 
         friend bool operator==(const DataProperty& lhs, const DataProperty& rhs)
@@ -80,6 +92,33 @@ namespace drug_lib::data
             return data_.size();
         }
 
+        /// @brief Arrays of strings and ids are written directly, others through get_info
+        void write_json(JsonWriter& writer) const override
+        {
+            if constexpr (std::is_same_v<DataPropertyType, std::string>)
+            {
+                writer.begin_array();
+                for (const auto& element : data_)
+                {
+                    writer.value(element);
+                }
+                writer.end_array();
+            }
+            else if constexpr (std::is_same_v<DataPropertyType, common::database::Uuid>)
+            {
+                writer.begin_array();
+                for (const auto& element : data_)
+                {
+                    writer.value(element.get_id());
+                }
+                writer.end_array();
+            }
+            else
+            {
+                DataProperty::write_json(writer);
+            }
+        }
+
         DataPropertyType operator[](const std::size_t index) const
         {
             if (index >= data_.size())
@@ -127,41 +166,246 @@ namespace drug_lib::data
         std::vector<DataPropertyType> data_;
     };
 
+    namespace detail
+    {
+        /// @brief Parse JSON text, malformed text gives null value
+        inline Json::Value parse_json(const std::string_view text)
+        {
+            thread_local const std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+            Json::Value result;
+            std::string errors;
+            if (!reader->parse(text.data(), text.data() + text.size(), &result, &errors))
+            {
+                return Json::nullValue;
+            }
+            return result;
+        }
+
+        inline std::size_t skip_spaces(const std::string_view json, std::size_t pos)
+        {
+            while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\t' || json[pos] == '\r'))
+            {
+                ++pos;
+            }
+            return pos;
+        }
+
+        /// @param pos Position of the opening quote
+        /// @return Position after the closing quote
+        inline std::size_t skip_string(const std::string_view json, std::size_t pos)
+        {
+            for (++pos; pos < json.size(); ++pos)
+            {
+                if (json[pos] == '\\')
+                {
+                    ++pos;
+                }
+                else if (json[pos] == '"')
+                {
+                    return pos + 1;
+                }
+            }
+            throw std::invalid_argument("Unterminated string in properties json");
+        }
+
+        /// @return Position after the value starting at pos
+        inline std::size_t skip_value(const std::string_view json, std::size_t pos)
+        {
+            if (pos < json.size() && json[pos] == '"')
+            {
+                return skip_string(json, pos);
+            }
+            if (pos < json.size() && (json[pos] == '{' || json[pos] == '['))
+            {
+                std::size_t depth = 0;
+                while (pos < json.size())
+                {
+                    const char c = json[pos];
+                    if (c == '"')
+                    {
+                        pos = skip_string(json, pos);
+                        continue;
+                    }
+                    ++pos;
+                    if (c == '{' || c == '[')
+                    {
+                        ++depth;
+                    }
+                    else if ((c == '}' || c == ']') && --depth == 0)
+                    {
+                        return pos;
+                    }
+                }
+                throw std::invalid_argument("Unterminated value in properties json");
+            }
+            // Number, true, false or null
+            while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && skip_spaces(json, pos) == pos)
+            {
+                ++pos;
+            }
+            return pos;
+        }
+
+        /// @brief Split top level members of the JSON object without decoding the values
+        /// @return Member names with views of their values in json. Empty for empty text and null
+        /// @throws std::invalid_argument If json isn't an object
+        inline std::vector<std::pair<std::string, std::string_view>> split_json_object(const std::string_view json)
+        {
+            std::vector<std::pair<std::string, std::string_view>> members;
+            std::size_t pos = skip_spaces(json, 0);
+            if (pos == json.size() || json.substr(pos, 4) == "null")
+            {
+                return members;
+            }
+            if (json[pos] != '{')
+            {
+                throw std::invalid_argument("Properties json isn't an object");
+            }
+            pos = skip_spaces(json, pos + 1);
+            if (pos < json.size() && json[pos] == '}')
+            {
+                return members;
+            }
+            while (pos < json.size())
+            {
+                if (json[pos] != '"')
+                {
+                    throw std::invalid_argument("Malformed properties json");
+                }
+                const std::size_t key_end = skip_string(json, pos);
+                const std::string_view key = json.substr(pos + 1, key_end - pos - 2);
+                std::string name = key.find('\\') == std::string_view::npos
+                                       ? std::string(key)
+                                       : parse_json(json.substr(pos, key_end - pos)).asString();
+                pos = skip_spaces(json, key_end);
+                if (pos == json.size() || json[pos] != ':')
+                {
+                    throw std::invalid_argument("Malformed properties json");
+                }
+                const std::size_t value_begin = skip_spaces(json, pos + 1);
+                const std::size_t value_end = skip_value(json, value_begin);
+                members.emplace_back(std::move(name), json.substr(value_begin, value_end - value_begin));
+                pos = skip_spaces(json, value_end);
+                if (pos < json.size() && json[pos] == ',')
+                {
+                    pos = skip_spaces(json, pos + 1);
+                    continue;
+                }
+                if (pos < json.size() && json[pos] == '}')
+                {
+                    return members;
+                }
+                throw std::invalid_argument("Malformed properties json");
+            }
+            throw std::invalid_argument("Malformed properties json");
+        }
+    }
+
+    /// @brief Properties of an object by name. Collection read from the database keeps the raw JSON text,
+    /// it is split into members on first access and each property is decoded on its first get_property.
+    /// Properties which weren't decoded are written back as they were read.
+    /// @warning Decoding mutates the collection, a collection shouldn't be read by several threads at once
     class PropertyCollection final
     {
     public:
+        /// @brief Replace the properties by the raw JSON object, nothing is decoded until accessed
+        void set_raw(std::string json)
+        {
+            m_data.clear();
+            raw_ = std::make_shared<const std::string>(std::move(json));
+            indexed_ = false;
+        }
+
         void add_property(const std::shared_ptr<DataProperty>& property)
         {
-            m_data[property->get_name()] = property;
+            index();
+            m_data[property->get_name()] = Entry{property, {}};
         }
 
         void remove_property(const std::shared_ptr<DataProperty>& property)
         {
-            m_data.erase(property->get_name());
+            remove_property(property->get_name());
         }
 
         void remove_property(const std::string& property_name)
         {
+            index();
             m_data.erase(property_name);
         }
 
+        /// @throws boost::container::out_of_range If there is no property with the name
         [[nodiscard]] std::shared_ptr<DataProperty> get_property(const std::string& property_name) const
         {
-            return m_data.at(property_name);
+            index();
+            Entry& entry = m_data.at(property_name);
+            if (!entry.property)
+            {
+                entry.property = decode(property_name, entry.raw);
+            }
+            return entry.property;
         }
 
         std::shared_ptr<DataProperty> operator[](const std::string& property_name) const
         {
-            return m_data.at(property_name);
+            return get_property(property_name);
         }
 
-        [[nodiscard]] Json::Value get_collection_info() const noexcept
+        /// @brief Values of the properties, the ones not decoded are only parsed
+        [[nodiscard]] Json::Value get_collection_info() const
         {
+            if (!indexed_)
+            {
+                return raw_ ? detail::parse_json(*raw_) : Json::Value();
+            }
             Json::Value result;
-            for (const auto& [name, property] : m_data)
+            for (const auto& [name, entry] : m_data)
+            {
+                result[name] = entry.property ? entry.property->get_info() : detail::parse_json(entry.raw);
+            }
+            return result;
+        }
+
+        /// @brief Write the properties as JSON object, null if there are none. The raw text is written as is
+        /// if the collection wasn't accessed, otherwise properties not decoded are copied from it
+        void write_json(JsonWriter& writer) const
+        {
+            if (!indexed_ && raw_)
+            {
+                if (detail::skip_spaces(*raw_, 0) == raw_->size())
+                {
+                    writer.null();
+                    return;
+                }
+                writer.raw(*raw_);
+                return;
+            }
+            if (m_data.empty())
             {
-                result[name] = property->get_info();
+                writer.null();
+                return;
             }
+            writer.begin_object();
+            for (const auto& [name, entry] : m_data)
+            {
+                writer.key(name);
+                if (entry.property)
+                {
+                    entry.property->write_json(writer);
+                }
+                else
+                {
+                    writer.raw(entry.raw);
+                }
+            }
+            writer.end_object();
+        }
+
+        /// @brief Properties as JSON object text, see write_json
+        [[nodiscard]] std::string to_json_text() const
+        {
+            std::string result;
+            JsonWriter writer(result);
+            write_json(writer);
             return result;
         }
 
@@ -169,6 +413,8 @@ namespace drug_lib::data
 
         friend bool operator==(const PropertyCollection& lhs, const PropertyCollection& rhs)
         {
+            lhs.index();
+            rhs.index();
             if (lhs.m_data.size() != rhs.m_data.size())
             {
                 return false;
@@ -178,7 +424,7 @@ namespace drug_lib::data
             return std::equal(
                 lhs.m_data.begin(), lhs.m_data.end(),
                 rhs.m_data.begin(),
-                [](const auto& lhs_pair, const auto& rhs_pair)
+                [&](const auto& lhs_pair, const auto& rhs_pair)
                 {
                     // Keys must match
                     if (lhs_pair.first != rhs_pair.first)
@@ -186,8 +432,8 @@ namespace drug_lib::data
                         return false;
                     }
                     // Values must match (dereference shared_ptr and compare contents)
-                    const auto& lhs_value = lhs_pair.second;
-                    const auto& rhs_value = rhs_pair.second;
+                    const auto lhs_value = lhs.get_property(lhs_pair.first);
+                    const auto rhs_value = rhs.get_property(rhs_pair.first);
                     return lhs_value && rhs_value && *lhs_value == *rhs_value;
                 });
         }
@@ -198,6 +444,37 @@ namespace drug_lib::data
         }
 
     private:
-        boost::container::flat_map<std::string, std::shared_ptr<DataProperty>> m_data;
+        struct Entry
+        {
+            // Null until the property is decoded
+            std::shared_ptr<DataProperty> property;
+            // Value in raw_ of the property not decoded yet
+            std::string_view raw;
+        };
+
+        /// @brief Make the property from its JSON value, defined with the property factory
+        /// @throws std::invalid_argument If the property name is unknown
+        static std::shared_ptr<DataProperty> decode(const std::string& property_name, std::string_view raw);
+
+        void index() const
+        {
+            if (indexed_)
+            {
+                return;
+            }
+            if (raw_)
+            {
+                for (auto& [name, value] : detail::split_json_object(*raw_))
+                {
+                    m_data[std::move(name)] = Entry{nullptr, value};
+                }
+            }
+            indexed_ = true;
+        }
+
+        mutable boost::container::flat_map<std::string, Entry> m_data;
+        // Shared by the copies, views of the entries point into it
+        std::shared_ptr<const std::string> raw_;
+        mutable bool indexed_ = true;
     };
 }
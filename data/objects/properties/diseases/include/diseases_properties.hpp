@@ -5,3 +5,16 @@
 #include "disease_properties/curative_drugs.hpp"
 #include "disease_properties/risk_factors.hpp"
 #include "disease_properties/symptoms.hpp"
+
+#include "property_registry.hpp"
+
+namespace drug_lib::data::objects::diseases
+{
+    /// @brief Properties of diseases known to PropertyFactory
+    using registered_properties = PropertyList<
+        RegisteredProperty<properties::symptoms, Symptoms>,
+        RegisteredProperty<properties::curative_drugs, CurativeDrugs>,
+        RegisteredProperty<properties::affected_age_groups, AffectedAgeGroups>,
+        RegisteredProperty<properties::complications, Complications>,
+        RegisteredProperty<properties::risk_factors, RiskFactors>>;
+}
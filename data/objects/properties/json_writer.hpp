@@ -0,0 +1,234 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <json/value.h>
+
+namespace drug_lib::data
+{
+    /// @brief Streaming JSON writer appending the text straight to the output buffer, no value tree is built.
+    /// Commas and colons are placed by the writer, the caller only keeps begin/end calls balanced.
+    /// Strings are written as UTF-8, control characters, quotes and backslashes are escaped
+    class JsonWriter final
+    {
+    public:
+        explicit JsonWriter(std::string& out)
+            : out_(out)
+        {
+        }
+
+        JsonWriter& begin_object()
+        {
+            separate();
+            out_ += '{';
+            comma_ = false;
+            return *this;
+        }
+
+        JsonWriter& end_object()
+        {
+            out_ += '}';
+            comma_ = true;
+            return *this;
+        }
+
+        JsonWriter& begin_array()
+        {
+            separate();
+            out_ += '[';
+            comma_ = false;
+            return *this;
+        }
+
+        JsonWriter& end_array()
+        {
+            out_ += ']';
+            comma_ = true;
+            return *this;
+        }
+
+        /// @brief Name of the next member of the current object
+        JsonWriter& key(const std::string_view name)
+        {
+            separate();
+            write_string(name);
+            out_ += ':';
+            comma_ = false;
+            return *this;
+        }
+
+        JsonWriter& value(const std::string_view text)
+        {
+            separate();
+            write_string(text);
+            comma_ = true;
+            return *this;
+        }
+
+        JsonWriter& value(const char* text)
+        {
+            return value(std::string_view(text));
+        }
+
+        JsonWriter& value(const std::string& text)
+        {
+            return value(std::string_view(text));
+        }
+
+        JsonWriter& value(const bool flag)
+        {
+            return raw(flag ? "true" : "false");
+        }
+
+        template <std::integral Integer>
+            requires (!std::same_as<Integer, bool> && !std::same_as<Integer, char>)
+        JsonWriter& value(const Integer number)
+        {
+            char buffer[24];
+            const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            return raw(std::string_view(buffer, end - buffer));
+        }
+
+        /// @brief Shortest text reading back to the same number, null for nan and infinity
+        JsonWriter& value(const double number)
+        {
+            if (!std::isfinite(number))
+            {
+                return null();
+            }
+            char buffer[32];
+            const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            return raw(std::string_view(buffer, end - buffer));
+        }
+
+        /// @brief Write the tree, for values which are still kept as Json::Value
+        JsonWriter& value(const Json::Value& tree)
+        {
+            switch (tree.type())
+            {
+            case Json::nullValue:
+                return null();
+            case Json::intValue:
+                return value(tree.asLargestInt());
+            case Json::uintValue:
+                return value(tree.asLargestUInt());
+            case Json::realValue:
+                return value(tree.asDouble());
+            case Json::stringValue:
+                {
+                    const char* begin = nullptr;
+                    const char* end = nullptr;
+                    tree.getString(&begin, &end);
+                    return value(std::string_view(begin, end - begin));
+                }
+            case Json::booleanValue:
+                return value(tree.asBool());
+            case Json::arrayValue:
+                begin_array();
+                for (const auto& element : tree)
+                {
+                    value(element);
+                }
+                return end_array();
+            case Json::objectValue:
+                begin_object();
+                for (auto it = tree.begin(); it != tree.end(); ++it)
+                {
+                    const char* end = nullptr;
+                    const char* begin = it.memberName(&end);
+                    key(std::string_view(begin, end - begin));
+                    value(*it);
+                }
+                return end_object();
+            }
+            return *this;
+        }
+
+        JsonWriter& null()
+        {
+            return raw("null");
+        }
+
+        /// @brief Write the value which is JSON text already, e.g. stored jsonb. The text isn't validated
+        JsonWriter& raw(const std::string_view json)
+        {
+            separate();
+            out_ += json;
+            comma_ = true;
+            return *this;
+        }
+
+        template <typename T>
+        JsonWriter& member(const std::string_view name, T&& member_value)
+        {
+            key(name);
+            return value(std::forward<T>(member_value));
+        }
+
+    private:
+        void separate()
+        {
+            if (comma_)
+            {
+                out_ += ',';
+            }
+        }
+
+        void write_string(const std::string_view text)
+        {
+            static constexpr char hex[] = "0123456789abcdef";
+            out_ += '"';
+            std::size_t clean = 0;
+            for (std::size_t i = 0; i < text.size(); ++i)
+            {
+                const auto c = static_cast<unsigned char>(text[i]);
+                if (c >= 0x20 && c != '"' && c != '\\')
+                {
+                    continue;
+                }
+                // Characters before the escaped one are copied at once
+                out_.append(text.data() + clean, i - clean);
+                clean = i + 1;
+                out_ += '\\';
+                switch (c)
+                {
+                case '"':
+                    out_ += '"';
+                    break;
+                case '\\':
+                    out_ += '\\';
+                    break;
+                case '\n':
+                    out_ += 'n';
+                    break;
+                case '\r':
+                    out_ += 'r';
+                    break;
+                case '\t':
+                    out_ += 't';
+                    break;
+                case '\b':
+                    out_ += 'b';
+                    break;
+                case '\f':
+                    out_ += 'f';
+                    break;
+                default:
+                    out_ += "u00";
+                    out_ += hex[c >> 4];
+                    out_ += hex[c & 0xF];
+                }
+            }
+            out_.append(text.data() + clean, text.size() - clean);
+            out_ += '"';
+        }
+
+        std::string& out_;
+        // Set after a complete value, the next value or key is preceded by a comma
+        bool comma_ = false;
+    };
+}
@@ -6,3 +6,17 @@
 #include "medicament_properties/prescription.hpp"
 #include "medicament_properties/side_effects.hpp"
 #include "medicament_properties/strength.hpp"
+
+#include "property_registry.hpp"
+
+namespace drug_lib::data::objects::medicaments
+{
+    /// @brief Properties of medicaments known to PropertyFactory
+    using registered_properties = PropertyList<
+        RegisteredProperty<properties::prescription, Prescription>,
+        RegisteredProperty<properties::active_ingredients, ActiveIngredients>,
+        RegisteredProperty<properties::inactive_ingredients, InactiveIngredients>,
+        RegisteredProperty<properties::dosage_form, DosageForm>,
+        RegisteredProperty<properties::side_effects, SideEffects>,
+        RegisteredProperty<properties::strength, Strength>>;
+}
@@ -2,4 +2,11 @@
 
 #include "organization_properties/license.hpp"
 
+#include "property_registry.hpp"
 
+namespace drug_lib::data::objects::organizations
+{
+    /// @brief Properties of organizations known to PropertyFactory
+    using registered_properties = PropertyList<
+        RegisteredProperty<properties::license, License>>;
+}
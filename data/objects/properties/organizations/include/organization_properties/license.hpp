@@ -37,6 +37,14 @@ namespace drug_lib::data::objects::organizations
             return license_params;
         }
 
+        void write_json(JsonWriter& writer) const override
+        {
+            writer.begin_object()
+                  .member(names_of_json_fields::license_name, license_name_)
+                  .member(names_of_json_fields::license_key, license_key_)
+                  .end_object();
+        }
+
         void set_info(const Json::Value& property) override
         {
             license_name_ = property[names_of_json_fields::license_name].asString();
@@ -7,3 +7,18 @@
 #include "patient_properties/insurance.hpp"
 #include "patient_properties/medical_history.hpp"
 #include "patient_properties/vaccines.hpp"
+
+#include "property_registry.hpp"
+
+namespace drug_lib::data::objects::patients
+{
+    /// @brief Properties of patients known to PropertyFactory
+    using registered_properties = PropertyList<
+        RegisteredProperty<properties::current_diseases, CurrentDiseases>,
+        RegisteredProperty<properties::current_medicaments, CurrentMedicaments>,
+        RegisteredProperty<properties::allergies, Allergies>,
+        RegisteredProperty<properties::blood_type, BloodType>,
+        RegisteredProperty<properties::insurance, Insurance>,
+        RegisteredProperty<properties::medical_history, MedicalHistory>,
+        RegisteredProperty<properties::vaccines, Vaccines>>;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "data_property.hpp"
+
+namespace drug_lib::data
+{
+    /// @brief Property type with the name it is stored under
+    template <const char* Name, typename PropertyType>
+        requires std::derived_from<PropertyType, DataProperty> && std::is_constructible_v<PropertyType, Json::Value>
+    struct RegisteredProperty
+    {
+        static constexpr std::string_view name = Name;
+
+        static std::shared_ptr<DataProperty> create(const Json::Value& property_value)
+        {
+            return std::make_shared<PropertyType>(property_value);
+        }
+    };
+
+    /// @brief Properties of one object kind, declared next to their headers
+    template <typename... Entries>
+    struct PropertyList
+    {
+    };
+
+    namespace detail
+    {
+        template <typename... Lists>
+        struct join_property_lists;
+
+        template <typename... Entries>
+        struct join_property_lists<PropertyList<Entries...>>
+        {
+            using type = PropertyList<Entries...>;
+        };
+
+        template <typename... First, typename... Second, typename... Rest>
+        struct join_property_lists<PropertyList<First...>, PropertyList<Second...>, Rest...>
+        {
+            using type = typename join_property_lists<PropertyList<First..., Second...>, Rest...>::type;
+        };
+    }
+
+    template <typename... Lists>
+    class PropertyRegistry;
+
+    /// @brief Constructors of the properties by name in a table built at compile time.
+    /// The hash seed is chosen so that every name has its own slot, lookup is a hash and one comparison
+    template <typename... Entries>
+    class PropertyRegistry<PropertyList<Entries...>>
+    {
+    public:
+        using Creator = std::shared_ptr<DataProperty>(*)(const Json::Value&);
+
+        static constexpr std::size_t size = sizeof...(Entries);
+
+        /// @return Constructor of the property, nullptr if the name isn't registered
+        [[nodiscard]] static constexpr Creator find(const std::string_view name) noexcept
+        {
+            const Slot& slot = slots_[hash(name, seed_) & (table_size_ - 1)];
+            return slot.name == name ? slot.create : nullptr;
+        }
+
+    private:
+        struct Slot
+        {
+            std::string_view name;
+            Creator create = nullptr;
+        };
+
+        static constexpr std::size_t table_size_ = std::bit_ceil(size * 2 + 1);
+
+        // FNV-1a with the seed mixed into the offset basis
+        static constexpr uint64_t hash(const std::string_view name, const uint64_t seed) noexcept
+        {
+            uint64_t result = 14695981039346656037ULL ^ seed;
+            for (const char c : name)
+            {
+                result ^= static_cast<unsigned char>(c);
+                result *= 1099511628211ULL;
+            }
+            return result ^ result >> 29;
+        }
+
+        static constexpr bool unique_names()
+        {
+            constexpr std::array<std::string_view, size> names = {Entries::name...};
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = i + 1; j < size; ++j)
+                {
+                    if (names[i] == names[j])
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static constexpr uint64_t find_seed()
+        {
+            constexpr std::array<std::string_view, size> names = {Entries::name...};
+            for (uint64_t seed = 0;; ++seed)
+            {
+                std::array<bool, table_size_> used = {};
+                bool collision = false;
+                for (const std::string_view name : names)
+                {
+                    bool& slot = used[hash(name, seed) & (table_size_ - 1)];
+                    collision = collision || slot;
+                    slot = true;
+                }
+                if (!collision)
+                {
+                    return seed;
+                }
+            }
+        }
+
+        static_assert(unique_names(), "Property is registered twice");
+
+        static constexpr uint64_t seed_ = find_seed();
+
+        static constexpr std::array<Slot, table_size_> slots_ = []
+        {
+            std::array<Slot, table_size_> slots = {};
+            ((slots[hash(Entries::name, seed_) & (table_size_ - 1)] = Slot{Entries::name, &Entries::create}), ...);
+            return slots;
+        }();
+    };
+
+    template <typename... Lists>
+        requires (sizeof...(Lists) > 1)
+    class PropertyRegistry<Lists...> : public PropertyRegistry<typename detail::join_property_lists<Lists...>::type>
+    {
+    };
+}
@@ -34,6 +34,12 @@ namespace drug_lib::services::drogon
 			this->set_up_db(connect);
 		}
 
+		explicit Authenticator(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Authenticator service has been created";
+			this->set_up_db(std::move(pool));
+		}
+
 		~Authenticator() override
 		{
 			LOG_INFO << "Authenticator has been destroyed";
@@ -55,5 +61,11 @@ namespace drug_lib::services::drogon
 			LOG_INFO << "Setting up auth db";
 			service_.setup_from_one(connect);
 		}
+
+		void set_up_db(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Setting up auth db pool";
+			service_.pool_setup(std::move(pool));
+		}
 	};
 }
@@ -2,14 +2,14 @@
 #include "authenticator.hpp"
 #include "config_utils.hpp"
 int main(const int argc, char *argv[]) {
-	std::shared_ptr dbConnection =
-		std::move(drug_lib::common::database::creational::DbInterfaceFactory::create_pqxx_client(
-			drug_lib::services::drogon::config_utils::create_params_from_config(
-				drug_lib::services::drogon::config_utils::get_json_config(argc, argv, "params"))));
+	// Load configuration first: the pool is sized by the number of request threads
+	drogon::app().loadConfigFile(
+		drug_lib::services::drogon::config_utils::get_path_config(argc, argv, "drogon_config"));
+	const auto pool = drug_lib::services::drogon::config_utils::create_pool_from_config(
+		drug_lib::services::drogon::config_utils::get_json_config(argc, argv, "params"), drogon::app().getThreadNum());
 
-	// Load configuration and run the Drogon application
 	drogon::app().registerController<drug_lib::services::drogon::Authenticator>(
-		std::make_shared<drug_lib::services::drogon::Authenticator>(dbConnection));
+		std::make_shared<drug_lib::services::drogon::Authenticator>(pool));
 
 	// Add a preflight (OPTIONS) handler
 	drogon::app().registerPreRoutingAdvice([](const drogon::HttpRequestPtr &req, drogon::AdviceCallback &&acb, drogon::AdviceChainCallback &&accb) {
@@ -33,8 +33,6 @@ int main(const int argc, char *argv[]) {
 		resp->addHeader("Access-Control-Allow-Headers", "Content-Type, Authorization, X-Requested-With");
 		resp->addHeader("Access-Control-Allow-Credentials", "true");
 	});
-	drogon::app().loadConfigFile(
-		drug_lib::services::drogon::config_utils::get_path_config(argc, argv, "drogon_config"));
 	drogon::app().run();
 	return 0;
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <json/json.h>
 #include <trantor/utils/Logger.h>
 
 #include "db_interface_factory.hpp"
+#include "db_interface_pool.hpp"
 namespace drug_lib::services::drogon::config_utils
 {
 	inline common::database::PqxxConnectParams create_params_from_config(const Json::Value &json)
@@ -15,9 +17,24 @@ namespace drug_lib::services::drogon::config_utils
 		params.set_db_name(json["db_name"].asString());
 		params.set_login(json["login"].asString());
 		params.set_password(json["password"].asString());
+		params.set_binary_jsonb(json.get("binary_jsonb", false).asBool());
 		return params;
 	}
 
+	/// @brief Pool with a connection per request thread, so handlers don't wait for each other
+	inline std::shared_ptr<common::database::creational::DbInterfacePool> create_pool_from_config(
+		const Json::Value &json, const std::size_t size)
+	{
+		common::database::creational::PoolSettings settings;
+		settings.min_size = std::max<std::size_t>(size, 1);
+		settings.max_size = settings.min_size;
+		settings.health_check_interval = std::chrono::seconds(30);
+		auto pool = std::make_shared<common::database::creational::DbInterfacePool>(settings);
+		pool->fill(settings.min_size, common::database::creational::DbInterfaceFactory::create_pqxx_client,
+		           create_params_from_config(json));
+		return pool;
+	}
+
 	inline std::string serve_path_for_config(const int argc, char *argv[])
 	{
 		const auto local_config_file = "./config/local/";
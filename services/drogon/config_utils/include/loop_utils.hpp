@@ -0,0 +1,24 @@
+#pragma once
+
+#include <functional>
+#include <trantor/net/EventLoop.h>
+
+#include "async_db_executor.hpp"
+
+namespace drug_lib::services::drogon::config_utils
+{
+	/// @brief Resumer returning the awaiting coroutine to the event loop of the calling thread,
+	/// so the response is built in the loop that owns the request
+	inline common::database::behavioral::AsyncDbExecutor::Resumer resume_in_current_loop()
+	{
+		trantor::EventLoop *loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+		if (loop == nullptr)
+		{
+			return {};
+		}
+		return [loop](std::function<void()> resume)
+		{
+			loop->queueInLoop(std::move(resume));
+		};
+	}
+}
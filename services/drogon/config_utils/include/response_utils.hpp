@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <drogon/HttpResponse.h>
+
+namespace drug_lib::services::drogon::config_utils
+{
+	/// @brief Response with the body which is JSON text already, e.g. written by JsonWriter.
+	/// Unlike newHttpJsonResponse the body isn't serialized again
+	inline ::drogon::HttpResponsePtr make_json_response(std::string body)
+	{
+		const auto response = ::drogon::HttpResponse::newHttpResponse();
+		response->setContentTypeCode(::drogon::CT_APPLICATION_JSON);
+		response->setBody(std::move(body));
+		return response;
+	}
+}
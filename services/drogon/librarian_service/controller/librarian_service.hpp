@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <drogon/HttpController.h>
+#include <drogon/utils/coroutine.h>
 
+#include "async_db_executor.hpp"
 #include "compile_time_utils.hpp"
+#include "loop_utils.hpp"
+#include "response_utils.hpp"
 #include "librarian_service_internal.hpp"
 
 namespace drug_lib::services::drogon
@@ -53,6 +59,12 @@ namespace drug_lib::services::drogon
 
 		static constexpr bool isAutoCreation = false;
 
+		explicit Librarian(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Librarian service has been created";
+			this->set_up_db(std::move(pool));
+		}
+
 		~Librarian() override
 		{
 			LOG_INFO << "Librarian service has been destroyed";
@@ -62,10 +74,24 @@ namespace drug_lib::services::drogon
 		void set_up_db(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
 		{
 			LOG_INFO << "Setting up search db";
+			service_.enable_cache();
 			service_.setup_from_one(connect);
+			executor_ = std::make_unique<common::database::behavioral::AsyncDbExecutor>(1);
+		}
+
+		void set_up_db(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Setting up search db pool";
+			// Worker per pooled connection, so workers never wait for a lease
+			const std::size_t workers = std::max<std::size_t>(pool->metrics().total, 1);
+			service_.enable_cache();
+			service_.pool_setup(std::move(pool));
+			executor_ = std::make_unique<common::database::behavioral::AsyncDbExecutor>(workers);
 		}
 
 		LibrarianServiceInternal service_;
+		// Declared after the service: pending work is finished before the service is destroyed
+		std::unique_ptr<common::database::behavioral::AsyncDbExecutor> executor_;
 
 		// Patient Methods
 		void get_patient(
@@ -134,31 +160,36 @@ namespace drug_lib::services::drogon
 			const ::drogon::HttpRequestPtr &req,
 			std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id);
 
-		// Shared Handlers for CRUD Operations
-		static void handle_get(const std::function<void(const ::drogon::HttpResponsePtr &)> &callback, const std::function<Json::Value()> &get_func)
+		// Shared Handlers for CRUD Operations.
+		// Database work runs on the executor, the event loop only waits for it, so it can serve other requests
+		/// @param get_func Returns the element as JSON text
+		void handle_get(std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, std::function<std::string()> &&get_func)
 		{
 			LOG_INFO << "Get element";
-			try
+			::drogon::async_run([this, callback = std::move(callback), get_func = std::move(get_func)]() -> ::drogon::Task<>
 			{
-				Json::Value wiki = get_func();
-				const auto response = ::drogon::HttpResponse::newHttpJsonResponse(std::move(wiki));
-				response->setStatusCode(::drogon::k200OK);
-				callback(response);
-			}
-			catch (const std::exception &e)
-			{
-				LOG_ERROR << "Caught exception: " << e.what();
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k404NotFound);
-				response->setBody(e.what());
-				callback(response);
-			}
+				try
+				{
+					std::string wiki = co_await executor_->run(get_func, config_utils::resume_in_current_loop());
+					const auto response = config_utils::make_json_response(std::move(wiki));
+					response->setStatusCode(::drogon::k200OK);
+					callback(response);
+				}
+				catch (const std::exception &e)
+				{
+					LOG_ERROR << "Caught exception: " << e.what();
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k404NotFound);
+					response->setBody(e.what());
+					callback(response);
+				}
+			});
 		}
 
 		template <typename UpdateFunction>
-		static void handle_update(
+		void handle_update(
 			const ::drogon::HttpRequestPtr &req,
-			std::function<void(const ::drogon::HttpResponsePtr &)> &callback, UpdateFunction update_func)
+			std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, UpdateFunction update_func)
 		{
 			LOG_INFO << "Update element";
 			if (const auto json = req->getJsonObject();
@@ -172,26 +203,29 @@ namespace drug_lib::services::drogon
 				return;
 			}
 
-			try
-			{
-				update_func();
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k200OK);
-				callback(response);
-			}
-			catch (const std::exception &e)
+			::drogon::async_run([this, callback = std::move(callback), update_func = std::move(update_func)]() -> ::drogon::Task<>
 			{
-				LOG_ERROR << "Error During conversion" << e.what();
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k500InternalServerError);
-				response->setBody(e.what());
-				callback(response);
-			}
+				try
+				{
+					co_await executor_->run(update_func, config_utils::resume_in_current_loop());
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k200OK);
+					callback(response);
+				}
+				catch (const std::exception &e)
+				{
+					LOG_ERROR << "Error During conversion" << e.what();
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k500InternalServerError);
+					response->setBody(e.what());
+					callback(response);
+				}
+			});
 		}
 
-		static void handle_add(
+		void handle_add(
 			const ::drogon::HttpRequestPtr &req,
-			const std::function<void(const ::drogon::HttpResponsePtr &)> &callback, const std::function<Json::Value()> &add_func)
+			std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, std::function<Json::Value()> &&add_func)
 		{
 			LOG_INFO << "Add element";
 			if (const auto json = req->getJsonObject();
@@ -204,40 +238,46 @@ namespace drug_lib::services::drogon
 				return;
 			}
 
-			try
-			{
-				Json::Value fetched = add_func();
-				const auto response = ::drogon::HttpResponse::newHttpJsonResponse(std::move(fetched));
-				response->setStatusCode(::drogon::k201Created);
-				callback(response);
-			}
-			catch (const std::exception &e)
+			::drogon::async_run([this, callback = std::move(callback), add_func = std::move(add_func)]() -> ::drogon::Task<>
 			{
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k500InternalServerError);
-				response->setBody(e.what());
-				callback(response);
-			}
+				try
+				{
+					Json::Value fetched = co_await executor_->run(add_func, config_utils::resume_in_current_loop());
+					const auto response = ::drogon::HttpResponse::newHttpJsonResponse(std::move(fetched));
+					response->setStatusCode(::drogon::k201Created);
+					callback(response);
+				}
+				catch (const std::exception &e)
+				{
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k500InternalServerError);
+					response->setBody(e.what());
+					callback(response);
+				}
+			});
 		}
 
 		template <typename RemoveFunction>
-		static void handle_remove(std::function<void(const ::drogon::HttpResponsePtr &)> &callback, RemoveFunction remove_func)
+		void handle_remove(std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, RemoveFunction remove_func)
 		{
 			LOG_INFO << "Remove element";
-			try
-			{
-				remove_func();
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k204NoContent);
-				callback(response);
-			}
-			catch (const std::exception &e)
+			::drogon::async_run([this, callback = std::move(callback), remove_func = std::move(remove_func)]() -> ::drogon::Task<>
 			{
-				const auto response = ::drogon::HttpResponse::newHttpResponse();
-				response->setStatusCode(::drogon::k500InternalServerError);
-				response->setBody(e.what());
-				callback(response);
-			}
+				try
+				{
+					co_await executor_->run(remove_func, config_utils::resume_in_current_loop());
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k204NoContent);
+					callback(response);
+				}
+				catch (const std::exception &e)
+				{
+					const auto response = ::drogon::HttpResponse::newHttpResponse();
+					response->setStatusCode(::drogon::k500InternalServerError);
+					response->setBody(e.what());
+					callback(response);
+				}
+			});
 		}
 	};
 } // namespace drug_lib::services::::drogon
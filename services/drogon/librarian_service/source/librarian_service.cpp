@@ -5,9 +5,9 @@ void drug_lib::services::drogon::Librarian::get_patient(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Get patient by id: " << id.get_id();
-	handle_get(callback, [&]()
+	handle_get(std::move(callback), [this, id]()
 	{
-		return service_.get_patient(id)->to_json();
+		return service_.get_patient(id)->to_json_text();
 	});
 }
 
@@ -16,7 +16,7 @@ void drug_lib::services::drogon::Librarian::update_patient(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Update patient by id: " << id.get_id();
-	handle_update(req, callback, [&]()
+	handle_update(req, std::move(callback), [this, req]()
 	{
 		data::objects::Patient patient;
 		patient.from_json(*req->getJsonObject());
@@ -28,7 +28,7 @@ void drug_lib::services::drogon::Librarian::add_patient(const ::drogon::HttpRequ
                                                         std::function<void(const ::drogon::HttpResponsePtr &)> &&callback)
 {
 	LOG_DEBUG << "Add patient...";
-	handle_add(req, callback, [&]()
+	handle_add(req, std::move(callback), [this, req]()
 	{
 		data::objects::Patient patient;
 		patient.from_json(*req->getJsonObject());
@@ -43,7 +43,7 @@ void drug_lib::services::drogon::Librarian::remove_patient(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Remove patient by id: " << id.get_id();
-	handle_remove(callback, [&]()
+	handle_remove(std::move(callback), [this, id]()
 	{
 		return service_.remove_patient(id);
 	});
@@ -54,9 +54,9 @@ void drug_lib::services::drogon::Librarian::get_disease(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Get disease by id: " << id.get_id();
-	handle_get(callback, [&]()
+	handle_get(std::move(callback), [this, id]()
 	{
-		return service_.get_disease(id)->to_json();
+		return service_.get_disease(id)->to_json_text();
 	});
 }
 
@@ -65,7 +65,7 @@ void drug_lib::services::drogon::Librarian::update_disease(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Update disease by id: " << id.get_id();
-	handle_update(req, callback, [&]()
+	handle_update(req, std::move(callback), [this, req]()
 	{
 		data::objects::Disease disease;
 		disease.from_json(*(req->getJsonObject()));
@@ -77,7 +77,7 @@ void drug_lib::services::drogon::Librarian::add_disease(const ::drogon::HttpRequ
                                                         std::function<void(const ::drogon::HttpResponsePtr &)> &&callback)
 {
 	LOG_DEBUG << "Add disease...";
-	handle_add(req, callback, [&]()
+	handle_add(req, std::move(callback), [this, req]()
 	{
 		data::objects::Disease disease;
 		disease.from_json(*req->getJsonObject());
@@ -92,7 +92,7 @@ void drug_lib::services::drogon::Librarian::remove_disease(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Remove disease by id: " << id.get_id();
-	handle_remove(callback, [&]()
+	handle_remove(std::move(callback), [this, id]()
 	{
 		return service_.remove_disease(id);
 	});
@@ -102,9 +102,9 @@ void drug_lib::services::drogon::Librarian::get_medicament(const ::drogon::HttpR
                                                            std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Get medicament by id: " << id.get_id();
-	handle_get(callback, [&]()
+	handle_get(std::move(callback), [this, id]()
 	{
-		return service_.get_medicament(id)->to_json();
+		return service_.get_medicament(id)->to_json_text();
 	});
 }
 
@@ -113,7 +113,7 @@ void drug_lib::services::drogon::Librarian::update_medicament(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Update medicament by id: " << id.get_id();
-	handle_update(req, callback, [&]()
+	handle_update(req, std::move(callback), [this, req]()
 	{
 		data::objects::Medicament drug;
 		drug.from_json(*req->getJsonObject());
@@ -125,7 +125,7 @@ void drug_lib::services::drogon::Librarian::add_medicament(const ::drogon::HttpR
                                                            std::function<void(const ::drogon::HttpResponsePtr &)> &&callback)
 {
 	LOG_DEBUG << "Add medicament...";
-	handle_add(req, callback, [&]()
+	handle_add(req, std::move(callback), [this, req]()
 	{
 		data::objects::Medicament drug;
 		drug.from_json(*req->getJsonObject());
@@ -139,7 +139,7 @@ void drug_lib::services::drogon::Librarian::remove_medicament(const ::drogon::Ht
                                                               std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Remove medicament by id: " << id.get_id();
-	handle_remove(callback, [&]()
+	handle_remove(std::move(callback), [this, id]()
 	{
 		return service_.remove_medicament(id);
 	});
@@ -149,9 +149,9 @@ void drug_lib::services::drogon::Librarian::get_organization(const ::drogon::Htt
                                                              std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Get organization by id: " << id.get_id();
-	handle_get(callback, [&]()
+	handle_get(std::move(callback), [this, id]()
 	{
-		return service_.get_organization(id)->to_json();
+		return service_.get_organization(id)->to_json_text();
 	});
 }
 
@@ -160,7 +160,7 @@ void drug_lib::services::drogon::Librarian::update_organization(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Update organization by id: " << id.get_id();
-	handle_update(req, callback, [&]()
+	handle_update(req, std::move(callback), [this, req]()
 	{
 		data::objects::Organization org;
 		org.from_json(*req->getJsonObject());
@@ -172,7 +172,7 @@ void drug_lib::services::drogon::Librarian::add_organization(const ::drogon::Htt
                                                              std::function<void(const ::drogon::HttpResponsePtr &)> &&callback)
 {
 	LOG_DEBUG << "Add organization...";
-	handle_add(req, callback, [&]()
+	handle_add(req, std::move(callback), [this, req]()
 	{
 		data::objects::Organization organization;
 		organization.from_json(*req->getJsonObject());
@@ -187,7 +187,7 @@ void drug_lib::services::drogon::Librarian::remove_organization(
 	std::function<void(const ::drogon::HttpResponsePtr &)> &&callback, const common::database::Uuid &id)
 {
 	LOG_DEBUG << "Remove organization by id: " << id.get_id();
-	handle_remove(callback, [&]()
+	handle_remove(std::move(callback), [this, id]()
 	{
 		return service_.remove_organization(id);
 	});
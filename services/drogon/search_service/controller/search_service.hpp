@@ -1,6 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <drogon/HttpController.h>
+#include <drogon/utils/coroutine.h>
+#include "async_db_executor.hpp"
+#include "loop_utils.hpp"
+#include "response_utils.hpp"
 #include "search_service_internal.hpp"
 #include "search_service_utils.hpp"
 namespace drug_lib::services::drogon
@@ -12,6 +18,9 @@ namespace drug_lib::services::drogon
 		{
 			static constexpr auto query_parameter = "query";
 			static constexpr auto page_number_parameter = "page";
+			/// Token of the keyset page, replaces page number. Empty token gives the first page
+			static constexpr auto page_token_parameter = "after";
+			static constexpr auto next_page_token_header = "X-Next-Page-Token";
 			static constexpr auto disease_search_endpoint = "/api/search/disease?query={pattern}&page={page}";
 			static constexpr auto medicament_search_endpoint = "/api/search/medicament?query={pattern}&page={page}";
 			static constexpr auto patient_search_endpoint = "/api/search/patient?query={pattern}&page={page}";
@@ -41,6 +50,12 @@ namespace drug_lib::services::drogon
 			set_up_db(connect);
 		}
 
+		explicit Search(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Search service has been created";
+			set_up_db(std::move(pool));
+		}
+
 		~Search() override
 		{
 			LOG_INFO << "Search service has been destroyed.";
@@ -67,9 +82,38 @@ namespace drug_lib::services::drogon
 		{
 			LOG_INFO << "Setting up search db";
 			service_.setup_from_one(connect);
+			executor_ = std::make_unique<common::database::behavioral::AsyncDbExecutor>(1);
+		}
+
+		void set_up_db(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
+		{
+			LOG_INFO << "Setting up search db pool";
+			// Worker per pooled connection, so workers never wait for a lease
+			const std::size_t workers = std::max<std::size_t>(pool->metrics().total, 1);
+			service_.pool_setup(std::move(pool));
+			executor_ = std::make_unique<common::database::behavioral::AsyncDbExecutor>(workers);
 		}
 
 	private:
+		/// @return True if the client pages by tokens instead of page numbers
+		static bool is_seek_request(const ::drogon::HttpRequestPtr &req)
+		{
+			return !req->getParameter(constants::page_token_parameter).empty() ||
+			       req->getParameter(constants::page_number_parameter).empty();
+		}
+
+		template <SearchableType T>
+		SearchResponse direct_search(const ::drogon::HttpRequestPtr &req)
+		{
+			if (is_seek_request(req))
+			{
+				return service_.direct_search_after<T>(req->getParameter(constants::query_parameter),
+				                                       req->getParameter(constants::page_token_parameter));
+			}
+			return service_.direct_search<T>(req->getParameter(constants::query_parameter),
+			                                 std::stoi(req->getParameter(constants::page_number_parameter)));
+		}
+
 		template<typename Func>
 		static SearchResponse handle_search(Func &&search_function)
 		{
@@ -95,23 +139,37 @@ namespace drug_lib::services::drogon
 			const ::drogon::HttpRequestPtr &req, std::function<void(const ::drogon::HttpResponsePtr &)> &&callback,
 			Func &&search_function)
 		{
-			try
-			{
-				LOG_INFO << "Searching for " << req->getPath() << "...";
-				LOG_INFO << "Where param is: " << req->getParameter(constants::query_parameter);
-				LOG_INFO << "Where page is: " << req->getParameter(constants::page_number_parameter);
-				auto internalResult = handle_search(std::forward<Func>(search_function));
-				const auto response = ::drogon::HttpResponse::newHttpJsonResponse(internalResult.to_json());
-				callback(response);
-			} catch (const std::exception &e)
-			{
-				const auto resp = ::drogon::HttpResponse::newHttpResponse();
-				resp->setStatusCode(::drogon::kUnknown);
-				resp->setBody(e.what());
-				callback(resp);
-			}
+			LOG_INFO << "Searching for " << req->getPath() << "...";
+			LOG_INFO << "Where param is: " << req->getParameter(constants::query_parameter);
+			LOG_INFO << "Where page is: " << req->getParameter(constants::page_number_parameter);
+			// Query runs on the executor, the event loop serves other requests meanwhile
+			::drogon::async_run(
+				[this, callback = std::move(callback), search_function = std::forward<Func>(search_function)]() mutable
+				-> ::drogon::Task<>
+				{
+					try
+					{
+						auto internalResult = co_await executor_->run(
+							[&search_function] { return handle_search(search_function); },
+							config_utils::resume_in_current_loop());
+						const auto response = config_utils::make_json_response(internalResult.to_json_text());
+						if (!internalResult.next_page_token().empty())
+						{
+							response->addHeader(constants::next_page_token_header, internalResult.next_page_token());
+						}
+						callback(response);
+					} catch (const std::exception &e)
+					{
+						const auto resp = ::drogon::HttpResponse::newHttpResponse();
+						resp->setStatusCode(::drogon::kUnknown);
+						resp->setBody(e.what());
+						callback(resp);
+					}
+				});
 		}
 
 		SearchServiceInternal service_;
+		// Declared after the service: pending work is finished before the service is destroyed
+		std::unique_ptr<common::database::behavioral::AsyncDbExecutor> executor_;
 	};
 } // namespace drug_lib::services::drogon
@@ -4,11 +4,9 @@ void drug_lib::services::drogon::Search::disease_search(
     const ::drogon::HttpRequestPtr& req, std::function<void(const ::drogon::HttpResponsePtr&)>&& callback)
 {
     execute_search(req, std::move(callback),
-                  [this, &req]
+                  [this, req]
                   {
-                      return service_.direct_search_diseases(
-                          req->getParameter(constants::query_parameter),
-                          std::stoi(req->getParameter(constants::page_number_parameter)));
+                      return direct_search<data::objects::Disease>(req);
                   });
 }
 
@@ -16,11 +14,9 @@ void drug_lib::services::drogon::Search::medicament_search(
     const ::drogon::HttpRequestPtr& req, std::function<void(const ::drogon::HttpResponsePtr&)>&& callback)
 {
     execute_search(req, std::move(callback),
-                  [this, &req]
+                  [this, req]
                   {
-                      return service_.direct_search_medicaments(
-                          req->getParameter(constants::query_parameter),
-                          std::stoi(req->getParameter(constants::page_number_parameter)));
+                      return direct_search<data::objects::Medicament>(req);
                   });
 }
 
@@ -28,11 +24,9 @@ void drug_lib::services::drogon::Search::patient_search(
     const ::drogon::HttpRequestPtr& req, std::function<void(const ::drogon::HttpResponsePtr&)>&& callback)
 {
     execute_search(req, std::move(callback),
-                  [this, &req]
+                  [this, req]
                   {
-                      return service_.direct_search_patients(
-                          req->getParameter(constants::query_parameter),
-                          std::stoi(req->getParameter(constants::page_number_parameter)));
+                      return direct_search<data::objects::Patient>(req);
                   });
 }
 
@@ -40,30 +34,33 @@ void drug_lib::services::drogon::Search::organization_search(
     const ::drogon::HttpRequestPtr& req, std::function<void(const ::drogon::HttpResponsePtr&)>&& callback)
 {
     execute_search(req, std::move(callback),
-                  [this, &req]
+                  [this, req]
                   {
-                      return service_.direct_search_organizations(
-                          req->getParameter(constants::query_parameter),
-                          std::stoi(req->getParameter(constants::page_number_parameter)));
+                      return direct_search<data::objects::Organization>(req);
                   });
 }
 void drug_lib::services::drogon::Search::search_through_all(
     const ::drogon::HttpRequestPtr& req, std::function<void(const ::drogon::HttpResponsePtr&)>&& callback)
 {
-    try
+    LOG_INFO << "Searching for " << req->getPath() << "...";
+    LOG_INFO << "Where param is: " << req->getParameter(constants::query_parameter);
+    ::drogon::async_run([this, req, callback = std::move(callback)]() -> ::drogon::Task<>
     {
-        LOG_INFO << "Searching for " << req->getPath() << "...";
-        LOG_INFO << "Where param is: " << req->getParameter(constants::query_parameter);
-        const auto internalResult = this->service_.open_search(req->getParameter(constants::query_parameter));
+        try
+        {
+            const auto internalResult = co_await executor_->run(
+                [this, &req] { return service_.open_search(req->getParameter(constants::query_parameter)); },
+                config_utils::resume_in_current_loop());
 
-        const auto response = ::drogon::HttpResponse::newHttpJsonResponse(internalResult.to_json());
-        callback(response);
-    }
-    catch (const std::exception& e)
-    {
-        const auto resp = ::drogon::HttpResponse::newHttpResponse();
-        resp->setStatusCode(::drogon::kUnknown);
-        resp->setBody(e.what());
-        callback(resp);
-    }
+            const auto response = config_utils::make_json_response(internalResult.to_json_text());
+            callback(response);
+        }
+        catch (const std::exception& e)
+        {
+            const auto resp = ::drogon::HttpResponse::newHttpResponse();
+            resp->setStatusCode(::drogon::kUnknown);
+            resp->setBody(e.what());
+            callback(resp);
+        }
+    });
 }
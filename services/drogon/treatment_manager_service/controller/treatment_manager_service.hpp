@@ -1,15 +1,26 @@
-
 #pragma once
 
+#include <memory>
 #include <drogon/HttpController.h>
 
+#include "treatment_manager_service_internal.hpp"
+
 namespace drug_lib::services::drogon {
 	class TreatmentManager final : public ::drogon::HttpController<TreatmentManager> {
 	public:
 		METHOD_LIST_BEGIN
 		METHOD_LIST_END
 		static constexpr bool isAutoCreation = false;
-		TreatmentManager() { LOG_INFO << "TreatmentManager service has been created"; }
+
+		explicit TreatmentManager(std::shared_ptr<common::database::creational::DbInterfacePool> pool) {
+			LOG_INFO << "TreatmentManager service has been created";
+			service_.enable_cache();
+			service_.pool_setup(std::move(pool));
+		}
+
 		~TreatmentManager() override { LOG_INFO << "TreatmentManager service has been destroyed"; }
+
+	private:
+		TreatmentManagerServiceInternal service_;
 	};
 } // namespace drug_lib::services::drogon
@@ -2,6 +2,7 @@
 #include "salt_generator.hpp"
 #include "hash_creator_factory.hpp"
 #include "auth_data_holder.hpp"
+#include "handbook_provider.hpp"
 #include "security_utils.hpp"
 
 namespace drug_lib::services
@@ -11,7 +12,7 @@ namespace drug_lib::services
 	public:
 		[[nodiscard]] bool login(const std::string_view username, const std::string_view password) const
 		{
-			if (const data::objects::AuthObject user = auth_data_holder_.get_by_login(username.data());
+			if (const data::objects::AuthObject user = auth_data_holder_.session()->get_by_login(username.data());
 				common::utilities::security::constant_time_compare(user.get_password_hash(),
 				                                                   hasher->hash_function(password, user.get_salt())))
 			{
@@ -31,15 +32,16 @@ namespace drug_lib::services
 			new_user.set_role(data::objects::auth::roles_names::sudo);
 			new_user.set_email(email.value_or("example@example.com"));
 			new_user.set_user_id(common::database::Uuid().set_null());
+			auto holder = auth_data_holder_.session();
 			try
 			{
-				data::objects::AuthObject user = auth_data_holder_.get_by_login(login.data());
+				data::objects::AuthObject user = holder->get_by_login(login.data());
 			}
 			catch (common::database::exceptions::InvalidIdentifierException &e)
 			{
 				if (e.get_error() == common::database::errors::db_error_code::RECORD_NOT_FOUND)
 				{
-					auth_data_holder_.insert(new_user);
+					holder->insert(new_user);
 					return;
 				}
 			}
@@ -53,12 +55,13 @@ namespace drug_lib::services
 
 		void setup_from_one(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
 		{
-			auth_data_holder_.set_connection(connect);
+			auth_data_holder_.setup_from_one(connect);
 		}
 
-		void pool_setup(common::database::creational::DbInterfacePool &pool)
+		/// @brief Each request leases own connection from the pool
+		void pool_setup(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
 		{
-			auth_data_holder_.establish_from_pool(pool);
+			auth_data_holder_.setup_from_pool(std::move(pool));
 		}
 
 		explicit AuthenticatorServiceInternal(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
@@ -69,6 +72,6 @@ namespace drug_lib::services
 
 	private:
 		std::unique_ptr<common::crypto::HashCreator> hasher;
-		dao::AuthDataHolder auth_data_holder_;
+		dao::HandbookProvider<dao::AuthDataHolder> auth_data_holder_;
 	};
 } // namespace drug_lib::services
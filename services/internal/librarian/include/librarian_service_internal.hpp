@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "handbook_provider.hpp"
 #include "super_handbook.hpp"
 
 namespace drug_lib::services
@@ -18,105 +19,123 @@ namespace drug_lib::services
 		// Medicament
 		std::unique_ptr<data::objects::ObjectBase> get_medicament(common::database::Uuid id)
 		{
-			return std::make_unique<data::objects::Medicament>(handbook_.medicaments().get_by_id(std::move(id)));
+			return std::make_unique<data::objects::Medicament>(handbooks_.session()->medicaments().get_by_id(std::move(id)));
 		}
 
 		void update_medicament(const data::objects::Medicament &element)
 		{
-			handbook_.medicaments().force_insert(element);
+			handbooks_.session()->medicaments().force_insert(element);
 		}
 
 		void add_medicament(data::objects::Medicament &element)
 		{
-			element.set_uuid( handbook_.medicaments().insert_without_id(element));
+			element.set_uuid( handbooks_.session()->medicaments().insert_without_id(element));
 		}
 
 		void remove_medicament(common::database::Uuid id)
 		{
-			handbook_.medicaments().remove_by_id(std::move(id));
+			handbooks_.session()->medicaments().remove_by_id(std::move(id));
 		}
 
 		// Disease
 		std::unique_ptr<data::objects::ObjectBase> get_disease(common::database::Uuid id)
 		{
-			return std::make_unique<data::objects::Disease>(handbook_.diseases().get_by_id(std::move(id)));
+			return std::make_unique<data::objects::Disease>(handbooks_.session()->diseases().get_by_id(std::move(id)));
 		}
 
 		void update_disease(const data::objects::Disease &element)
 		{
-			handbook_.diseases().force_insert(element);
+			handbooks_.session()->diseases().force_insert(element);
 		}
 
 		void add_disease(data::objects::Disease &element)
 		{
-			element.set_uuid( handbook_.diseases().insert_without_id(element));
+			element.set_uuid( handbooks_.session()->diseases().insert_without_id(element));
 		}
 
 		void remove_disease(common::database::Uuid id)
 		{
-			handbook_.diseases().remove_by_id(std::move(id));
+			handbooks_.session()->diseases().remove_by_id(std::move(id));
 		}
 
 		// Organization
 		std::unique_ptr<data::objects::ObjectBase> get_organization(common::database::Uuid id)
 		{
-			return std::make_unique<data::objects::Organization>(handbook_.organizations().get_by_id(std::move(id)));
+			return std::make_unique<data::objects::Organization>(handbooks_.session()->organizations().get_by_id(std::move(id)));
 		}
 
 		void update_organization(const data::objects::Organization &element)
 		{
-			handbook_.organizations().force_insert(element);
+			handbooks_.session()->organizations().force_insert(element);
 		}
 
 		void add_organization(data::objects::Organization &element)
 		{
-			element.set_uuid( handbook_.organizations().insert_without_id(element));
+			element.set_uuid( handbooks_.session()->organizations().insert_without_id(element));
 		}
 
 		void remove_organization(common::database::Uuid id)
 		{
-			handbook_.organizations().remove_by_id(std::move(id));
+			handbooks_.session()->organizations().remove_by_id(std::move(id));
 		}
 
 		// Patient
 		std::unique_ptr<data::objects::ObjectBase> get_patient(common::database::Uuid id)
 		{
-			return std::make_unique<data::objects::Patient>(handbook_.patients().get_by_id(std::move(id)));
+			return std::make_unique<data::objects::Patient>(handbooks_.session()->patients().get_by_id(std::move(id)));
 		}
 
 		void update_patient(const data::objects::Patient &element)
 		{
-			handbook_.patients().force_insert(element);
+			handbooks_.session()->patients().force_insert(element);
 		}
 
 		void add_patient(data::objects::Patient &element)
 		{
-			element.set_uuid( handbook_.patients().insert_without_id(element));
+			element.set_uuid( handbooks_.session()->patients().insert_without_id(element));
 		}
 
 		void remove_patient(common::database::Uuid id)
 		{
-			handbook_.patients().remove_by_id(std::move(id));
+			handbooks_.session()->patients().remove_by_id(std::move(id));
+		}
+
+		/// @brief Serve repeated reads of medicaments and diseases from memory, see SuperHandbook::enable_reference_cache
+		void enable_cache(const dao::CacheSettings &settings = {})
+		{
+			handbooks_.configure([&settings](dao::SuperHandbook &handbook) { handbook.enable_reference_cache(settings); });
+		}
+
+		[[nodiscard]] dao::CacheMetrics medicaments_cache_metrics() const
+		{
+			return handbooks_.prototype().medicaments().cache_metrics();
+		}
+
+		[[nodiscard]] dao::CacheMetrics diseases_cache_metrics() const
+		{
+			return handbooks_.prototype().diseases().cache_metrics();
 		}
 
 		void setup_from_one(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
 		{
-			handbook_.direct_establish(connect);
+			handbooks_.setup_from_one(connect);
 		}
 
-		void pool_setup(common::database::creational::DbInterfacePool &pool)
+		/// @brief Each request leases own connection from the pool
+		void pool_setup(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
 		{
-			handbook_.establish_from_pool(pool);
+			handbooks_.setup_from_pool(std::move(pool));
 		}
 
 		explicit LibrarianServiceInternal(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
 		{
+			enable_cache();
 			setup_from_one(connect);
 		}
 
 		LibrarianServiceInternal() = default;
 
 	private:
-		dao::SuperHandbook handbook_;
+		dao::HandbookProvider<dao::SuperHandbook> handbooks_;
 	};
 } // namespace drug_lib::services
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace drug_lib::services
+{
+	/// @brief Levenshtein distance from one pattern to many texts.
+	/// Patterns up to 64 symbols are matched bit-parallel (Myers, Hyyro): a column of the table is kept in two
+	/// words, so a text symbol costs a few word operations. Longer patterns fall back to the table row by row
+	class EditDistance
+	{
+	public:
+		static constexpr std::size_t word_size = 64;
+
+		explicit EditDistance(std::u32string pattern)
+			: pattern_(std::move(pattern))
+		{
+			if (pattern_.empty() || pattern_.size() > word_size)
+			{
+				return;
+			}
+			for (std::size_t i = 0; i < pattern_.size(); ++i)
+			{
+				const char32_t symbol = pattern_[i];
+				const uint64_t bit = uint64_t{1} << i;
+				if (symbol < ascii_.size())
+				{
+					ascii_[symbol] |= bit;
+					continue;
+				}
+				const auto it = std::ranges::lower_bound(other_, symbol, {}, &std::pair<char32_t, uint64_t>::first);
+				if (it != other_.end() && it->first == symbol)
+				{
+					it->second |= bit;
+				}
+				else
+				{
+					other_.emplace(it, symbol, bit);
+				}
+			}
+			last_ = uint64_t{1} << (pattern_.size() - 1);
+		}
+
+		[[nodiscard]] const std::u32string &pattern() const
+		{
+			return pattern_;
+		}
+
+		[[nodiscard]] uint32_t operator()(const std::u32string_view text) const
+		{
+			return bounded(text, UINT32_MAX - 1);
+		}
+
+		/// @brief Distance, or max_distance + 1 if it is greater.
+		/// Stops as soon as the rest of the text can't bring the distance back within the bound
+		[[nodiscard]] uint32_t bounded(const std::u32string_view text, const uint32_t max_distance) const
+		{
+			const std::size_t m = pattern_.size();
+			const std::size_t n = text.size();
+			if ((m > n ? m - n : n - m) > max_distance)
+			{
+				return max_distance + 1;
+			}
+			if (m == 0)
+			{
+				return static_cast<uint32_t>(n);
+			}
+			if (m > word_size)
+			{
+				return bounded_by_rows(text, max_distance);
+			}
+			uint64_t positive = ~uint64_t{0};
+			uint64_t negative = 0;
+			uint64_t score = m;
+			for (std::size_t j = 0; j < n; ++j)
+			{
+				step(match(text[j]), positive, negative, score);
+				// Each of the remaining symbols lowers the distance at most by one
+				if (score > max_distance + (n - j - 1))
+				{
+					return max_distance + 1;
+				}
+			}
+			return static_cast<uint32_t>(std::min<uint64_t>(score, max_distance + 1));
+		}
+
+		/// @brief Bounded distances to all texts, e.g. to rerank candidates fetched from the database.
+		/// Most candidates are rejected by the length or after a few symbols, which is faster than scoring
+		/// several texts in lanes of a vector register: texts end at different symbols and each lane needs
+		/// own lookup of the symbol mask
+		/// @param distances Output, one per text
+		void bounded(const std::span<const std::u32string> texts, const uint32_t max_distance,
+		             const std::span<uint32_t> distances) const
+		{
+			for (std::size_t i = 0; i < texts.size(); ++i)
+			{
+				distances[i] = bounded(texts[i], max_distance);
+			}
+		}
+
+	private:
+		[[nodiscard]] uint64_t match(const char32_t symbol) const
+		{
+			if (symbol < ascii_.size())
+			{
+				return ascii_[symbol];
+			}
+			const auto it = std::ranges::lower_bound(other_, symbol, {}, &std::pair<char32_t, uint64_t>::first);
+			return it != other_.end() && it->first == symbol ? it->second : 0;
+		}
+
+		/// @brief Next column from the vertical deltas of the previous one, bits above the pattern are ignored
+		void step(const uint64_t equal, uint64_t &positive, uint64_t &negative, uint64_t &score) const
+		{
+			const uint64_t vertical = equal | negative;
+			const uint64_t diagonal = (((equal & positive) + positive) ^ positive) | equal;
+			uint64_t horizontal_positive = negative | ~(diagonal | positive);
+			uint64_t horizontal_negative = positive & diagonal;
+			score += (horizontal_positive & last_) != 0;
+			score -= (horizontal_negative & last_) != 0;
+			// First row of the table grows by one in each column
+			horizontal_positive = horizontal_positive << 1 | 1;
+			horizontal_negative <<= 1;
+			positive = horizontal_negative | ~(vertical | horizontal_positive);
+			negative = horizontal_positive & vertical;
+		}
+
+		[[nodiscard]] uint32_t bounded_by_rows(const std::u32string_view text, const uint32_t max_distance) const
+		{
+			std::vector<uint32_t> row(pattern_.size() + 1);
+			for (std::size_t i = 0; i < row.size(); ++i)
+			{
+				row[i] = static_cast<uint32_t>(i);
+			}
+			for (std::size_t j = 0; j < text.size(); ++j)
+			{
+				uint32_t diagonal = row[0];
+				row[0] = static_cast<uint32_t>(j + 1);
+				uint32_t row_min = row[0];
+				for (std::size_t i = 1; i < row.size(); ++i)
+				{
+					const uint32_t above = row[i];
+					row[i] = std::min({above + 1, row[i - 1] + 1, diagonal + (pattern_[i - 1] == text[j] ? 0u : 1u)});
+					diagonal = above;
+					row_min = std::min(row_min, row[i]);
+				}
+				if (row_min > max_distance)
+				{
+					return max_distance + 1;
+				}
+			}
+			return std::min(row.back(), max_distance + 1);
+		}
+
+		std::u32string pattern_;
+		// Bits of the pattern positions holding the symbol
+		std::array<uint64_t, 128> ascii_{};
+		std::vector<std::pair<char32_t, uint64_t>> other_;
+		uint64_t last_ = 0;
+	};
+} // namespace drug_lib::services
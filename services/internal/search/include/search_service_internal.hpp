@@ -1,5 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+
+#include "async_db_executor.hpp"
+#include "edit_distance.hpp"
+#include "handbook_provider.hpp"
+#include "suggest_index.hpp"
 #include "super_handbook.hpp"
 
 namespace drug_lib::services
@@ -21,6 +36,8 @@ namespace drug_lib::services
 		{
 			std::unique_ptr<data::objects::ObjectBase> object;
 			MatchStatus status;
+			/// Set for the results ranked by the database, greater is more relevant
+			std::optional<double> relevance;
 		};
 
 		void add(std::unique_ptr<data::objects::ObjectBase> &&object, MatchStatus status = PARTIAL_MATCH)
@@ -34,6 +51,42 @@ namespace drug_lib::services
 			results_.emplace_back(std::make_unique<T>(std::forward<T>(object)), status);
 		}
 
+		template <SearchableType T>
+		void add_scored(T &&object, const MatchStatus status, const double relevance)
+		{
+			results_.emplace_back(std::make_unique<T>(std::forward<T>(object)), status, relevance);
+		}
+
+		/// @brief Add records of HandbookBase::ranked_search keeping their order, exact matches are perfect ones
+		template <typename Ranked>
+			requires requires(Ranked ranked) { ranked.record; ranked.relevance; ranked.exact; }
+		void add_ranked(std::vector<Ranked> &&ranked)
+		{
+			for (auto &[record, relevance, exact]: ranked)
+			{
+				results_.emplace_back(std::make_unique<decltype(record)>(std::move(record)),
+				                      exact ? PERFECT_MATCH : PARTIAL_MATCH, relevance);
+			}
+		}
+
+		/// @brief Add the matches of the other response after the own ones
+		void merge(SearchResponse &&other)
+		{
+			results_.reserve(results_.size() + other.results_.size());
+			std::ranges::move(other.results_, std::back_inserter(results_));
+			other.results_.clear();
+		}
+
+		/// @brief Order matches by relevance, most relevant first. Order of equal ones is kept,
+		/// matches without relevance go last
+		void sort_by_relevance()
+		{
+			std::ranges::stable_sort(results_, std::ranges::greater{}, [](const Match &match)
+			{
+				return match.relevance.value_or(-std::numeric_limits<double>::infinity());
+			});
+		}
+
 		void pop()
 		{
 			results_.pop_back();
@@ -66,21 +119,55 @@ namespace drug_lib::services
 			Json::Value response(Json::arrayValue);
 			for (const auto &object: results_)
 			{
-				const auto &[obj, match] = object;
-				Json::Value match_object = obj->to_json();;
-				switch (match)
+				const auto &[obj, match, relevance] = object;
+				Json::Value match_object = obj->to_json();
+				match_object["match"] = match_name(match);
+				if (relevance.has_value())
 				{
-					case MatchStatus::PERFECT_MATCH:
-						match_object["match"] = "PERFECT_MATCH";
-					case MatchStatus::PARTIAL_MATCH:
-						match_object["match"] = "PARTIAL_MATCH";
+					match_object["relevance"] = relevance.value();
 				}
-
 				response.append(match_object);
 			}
 			return response;
 		}
 
+		/// @brief Write the response as to_json does, objects are streamed into the writer buffer
+		void write_json(data::JsonWriter &writer) const
+		{
+			writer.begin_array();
+			for (const auto &[obj, match, relevance]: results_)
+			{
+				writer.begin_object();
+				obj->write_members(writer);
+				writer.member("match", match_name(match));
+				if (relevance.has_value())
+				{
+					writer.member("relevance", relevance.value());
+				}
+				writer.end_object();
+			}
+			writer.end_array();
+		}
+
+		[[nodiscard]] std::string to_json_text() const
+		{
+			std::string result;
+			data::JsonWriter writer(result);
+			write_json(writer);
+			return result;
+		}
+
+		/// @brief Token of the next keyset page, empty if there is no next page
+		[[nodiscard]] const std::string &next_page_token() const
+		{
+			return next_page_token_;
+		}
+
+		void set_next_page_token(std::string token)
+		{
+			next_page_token_ = std::move(token);
+		}
+
 		[[nodiscard]] std::vector<Match>::const_iterator begin() const
 		{
 			return results_.cbegin();
@@ -92,68 +179,95 @@ namespace drug_lib::services
 		}
 
 	private:
+		static const char *match_name(const MatchStatus status)
+		{
+			return status == PERFECT_MATCH ? "PERFECT_MATCH" : "PARTIAL_MATCH";
+		}
+
 		std::vector<Match> results_;
+		std::string next_page_token_;
 	};
 
 	class SearchServiceInternal
 	{
 	public:
+		/// @brief Exact matches of all handbooks
 		SearchResponse search_through_all(const std::string &pattern);
 
+		/// @brief Similar medicaments and diseases, merged by the edit distance between their names and the pattern
 		SearchResponse open_search(const std::string &pattern);
 
+		/// @brief Number of the last page of the handbook, counted from the estimated count of records
 		template <SearchableType T>
 		std::size_t get_last_page_number()
 		{
-			if constexpr (std::is_same_v<T, data::objects::Medicament>)
-			{
-				return handbook_.medicaments().count_all() / page_limit_;
-			}
-			else if (std::is_same_v<T, data::objects::Disease>)
-			{
-				return handbook_.diseases().count_all() / page_limit_;
-			}
-			else if (std::is_same_v<T, data::objects::Organization>)
-			{
-				return handbook_.organizations().count_all() / page_limit_;
-			}
-			else if (std::is_same_v<T, data::objects::Patient>)
-			{
-				return handbook_.patients().count_all() / page_limit_;
-			}
-			else
-			{
-				throw std::invalid_argument("Invalid search type");
-			}
+			return (count_of<T>() + page_limit_ - 1) / page_limit_;
 		}
 
+		/// @brief Page of exact and similar matches ranked together by relevance
+		template <SearchableType T>
+		SearchResponse direct_search(const std::string &pattern, const std::size_t page_number = 1)
+		{
+			auto handbook = handbooks_.session();
+			SearchResponse result;
+			result.add_ranked(handbook_of<T>(*handbook).ranked_search(pattern, page_limit_, page_number));
+			return result;
+		}
 
-		SearchResponse direct_search_medicaments(
-			const std::string &pattern,
-			std::size_t page_number = 1);
+		/// @brief Exact matches by keyset pages, page after the token costs the same as the first one
+		/// @param page_token Token of the previous page (SearchResponse::next_page_token), empty for the first page
+		/// @throws std::invalid_argument If the token is malformed
+		template <SearchableType T>
+		SearchResponse direct_search_after(const std::string &pattern, const std::string &page_token = {})
+		{
+			auto handbook = handbooks_.session();
+			auto [records, next_token] = handbook_of<T>(*handbook).search_after(pattern, page_limit_, page_token);
+			SearchResponse result;
+			result.add(std::move(records), SearchResponse::PERFECT_MATCH);
+			result.set_next_page_token(std::move(next_token));
+			return result;
+		}
 
-		SearchResponse direct_search_diseases(
-			const std::string &pattern,
-			std::size_t page_number = 1);
+		/// @brief Names of medicaments, diseases and organizations completing the pattern, typos are tolerated.
+		/// Answered from memory, names are loaded from the handbooks by the first call
+		std::vector<std::string> suggest(const std::string &pattern);
 
-		SearchResponse direct_search_organizations(
-			const std::string &pattern,
-			std::size_t page_number = 1);
+		/// @brief Reload the suggested names from the handbooks
+		void refresh_suggestions();
 
-		SearchResponse direct_search_patients(
-			const std::string &pattern,
-			std::size_t page_number = 1);
+		/// @brief Keep suggestions up to date when a medicament, disease or organization is added or renamed
+		void add_suggestion(const std::string &name);
 
-		std::vector<std::string> suggest(const std::string &pattern);
+		void remove_suggestion(const std::string &name);
+
+		/// @brief Searches of several handbooks wait for the slower ones no longer than the deadline,
+		/// the late handbooks are left out of the response and their queries are cancelled. Used with a pool only
+		void set_search_deadline(const std::chrono::milliseconds deadline)
+		{
+			search_deadline_ = deadline;
+		}
+
+		/// @brief Counts of records for pagination are estimated once per the period
+		void set_count_ttl(const std::chrono::milliseconds ttl)
+		{
+			count_ttl_ = ttl;
+		}
 
 		void setup_from_one(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
 		{
-			handbook_.direct_establish(connect);
+			fan_out_.reset();
+			forget_counts();
+			handbooks_.setup_from_one(connect);
 		}
 
-		void pool_setup(common::database::creational::DbInterfacePool &pool)
+		/// @brief Each request leases own connection from the pool, searches of several handbooks run
+		/// concurrently on own connections
+		void pool_setup(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
 		{
-			handbook_.establish_from_pool(pool);
+			const std::size_t workers = std::max<std::size_t>(pool->metrics().total, 1);
+			forget_counts();
+			handbooks_.setup_from_pool(std::move(pool));
+			fan_out_ = std::make_unique<common::database::behavioral::AsyncDbExecutor>(workers);
 		}
 
 		explicit SearchServiceInternal(const std::shared_ptr<common::database::interfaces::DbInterface> &connect)
@@ -164,10 +278,136 @@ namespace drug_lib::services
 		SearchServiceInternal() = default;
 
 	private:
-		static uint32_t editor_distance(const std::string &suggest, const std::string &pattern);
+		/// @brief Query of one handbook and the response made of its rows
+		struct SubSearch
+		{
+			common::database::interfaces::ViewQuery query;
+			std::function<SearchResponse(const std::vector<std::unique_ptr<common::database::ViewRecord>> &)> respond;
+		};
+
+		template <SearchableType T, typename Handbooks>
+		static auto &handbook_of(Handbooks &handbooks)
+		{
+			if constexpr (std::is_same_v<T, data::objects::Medicament>)
+			{
+				return handbooks.medicaments();
+			}
+			else if constexpr (std::is_same_v<T, data::objects::Disease>)
+			{
+				return handbooks.diseases();
+			}
+			else if constexpr (std::is_same_v<T, data::objects::Organization>)
+			{
+				return handbooks.organizations();
+			}
+			else
+			{
+				return handbooks.patients();
+			}
+		}
+
+		template <SearchableType T>
+		SubSearch exact_search(const std::string &pattern) const
+		{
+			using Handbook = std::remove_cvref_t<decltype(handbook_of<T>(handbooks_.prototype()))>;
+			return {
+				handbook_of<T>(handbooks_.prototype()).search_query(pattern, page_limit_),
+				[](const std::vector<std::unique_ptr<common::database::ViewRecord>> &rows)
+				{
+					SearchResponse response;
+					response.add(Handbook::to_records(rows), SearchResponse::PERFECT_MATCH);
+					return response;
+				}
+			};
+		}
+
+		/// @brief Similar records scored by the edit distance between their names and the pattern
+		template <SearchableType T>
+		SubSearch fuzzy_search(const std::string &pattern) const
+		{
+			using Handbook = std::remove_cvref_t<decltype(handbook_of<T>(handbooks_.prototype()))>;
+			return {
+				handbook_of<T>(handbooks_.prototype()).fuzzy_search_query(pattern, page_limit_),
+				[folded = SuggestIndex::fold(pattern)](
+				const std::vector<std::unique_ptr<common::database::ViewRecord>> &rows)
+				{
+					auto records = Handbook::to_records(rows);
+					std::vector<std::u32string> names;
+					names.reserve(records.size());
+					for (const auto &record: records)
+					{
+						names.push_back(SuggestIndex::fold(record.get_name()));
+					}
+					std::vector<uint32_t> distances(names.size());
+					EditDistance(folded).bounded(names, UINT32_MAX - 1, distances);
+					SearchResponse response;
+					for (std::size_t i = 0; i < records.size(); ++i)
+					{
+						response.add_scored(std::move(records[i]), SearchResponse::PARTIAL_MATCH,
+						                    1. / (1. + distances[i]));
+					}
+					return response;
+				}
+			};
+		}
+
+		/// @brief Estimated count of records of the handbook, reused until it expires
+		template <SearchableType T>
+		uint32_t count_of()
+		{
+			const auto now = std::chrono::steady_clock::now();
+			{
+				std::lock_guard lock(counts_mutex_);
+				if (const auto it = counts_.find(typeid(T)); it != counts_.end() && it->second.expires > now)
+				{
+					return it->second.value;
+				}
+			}
+			auto handbook = handbooks_.session();
+			const uint32_t value = handbook_of<T>(*handbook).estimate_all();
+			std::lock_guard lock(counts_mutex_);
+			counts_.insert_or_assign(typeid(T), CachedCount{value, now + count_ttl_});
+			return value;
+		}
+
+		void forget_counts()
+		{
+			std::lock_guard lock(counts_mutex_);
+			counts_.clear();
+		}
+
+		/// @brief Run the searches and merge their responses in the order of the searches.
+		/// With a pool each search runs concurrently on own connection, otherwise all go in one round-trip
+		SearchResponse fan_out(std::vector<SubSearch> &&searches);
+
+		/// @brief Run the search on own connection, the query is cancelled at the deadline
+		/// @return Empty if the search missed the deadline
+		std::optional<SearchResponse> search_until(const SubSearch &search,
+		                                           std::chrono::steady_clock::time_point deadline) const;
+
+		/// @brief Edits tolerated in the pattern, the temperature is the percentage of mistyped symbols
+		[[nodiscard]] uint32_t suggest_distance(const std::string &pattern) const;
+
+		static constexpr uint32_t max_suggest_distance = 3;
 
 		uint8_t page_limit_ = 10;
 		uint8_t suggest_temperature_ = 12; // 0 - 100
-		dao::SuperHandbook handbook_;
+		std::chrono::milliseconds search_deadline_ = std::chrono::seconds(5);
+		std::chrono::milliseconds count_ttl_ = std::chrono::seconds(30);
+		dao::HandbookProvider<dao::SuperHandbook> handbooks_;
+		SuggestIndex suggestions_;
+		mutable std::shared_mutex suggestions_mutex_;
+		std::once_flag suggestions_loaded_;
+
+		struct CachedCount
+		{
+			uint32_t value;
+			std::chrono::steady_clock::time_point expires;
+		};
+
+		std::unordered_map<std::type_index, CachedCount> counts_;
+		std::mutex counts_mutex_;
+		// Declared last: searches still running after the deadline are finished before the handbooks are destroyed
+		std::unique_ptr<common::database::behavioral::AsyncDbExecutor> fan_out_;
 	};
 } // namespace drug_lib::services
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace drug_lib::services
+{
+	/// @brief In-memory autocomplete over names: a trie of case folded code points.
+	/// Suggestions are names which start with the pattern, or with a string within max_distance edits of it.
+	/// Typos are found by walking the trie with a row of the Levenshtein table, so branches which can't come
+	/// within the distance are cut at once, as well as branches whose names are all longer than the found ones.
+	/// Names are added and removed one by one, nodes of the removed names are kept and reused when the name comes back
+	class SuggestIndex
+	{
+	public:
+		/// @brief Add the name, the same name may be added from several handbooks
+		void add(const std::string_view name)
+		{
+			const std::u32string key = fold(name);
+			if (key.empty())
+			{
+				return;
+			}
+			uint32_t node = 0;
+			const auto length = static_cast<uint32_t>(key.size());
+			for (const char32_t symbol: key)
+			{
+				node = child(node, symbol, true);
+				nodes_[node].shortest = std::min(nodes_[node].shortest, length);
+			}
+			Node &terminal = nodes_[node];
+			if (terminal.references++ == 0)
+			{
+				terminal.name = name;
+				++size_;
+			}
+		}
+
+		/// @brief Drop one reference to the name, it isn't suggested when all of them are dropped
+		void remove(const std::string_view name)
+		{
+			uint32_t node = 0;
+			for (const char32_t symbol: fold(name))
+			{
+				node = child(node, symbol, false);
+				if (node == absent)
+				{
+					return;
+				}
+			}
+			Node &terminal = nodes_[node];
+			if (terminal.references > 0 && --terminal.references == 0)
+			{
+				terminal.name.clear();
+				--size_;
+			}
+		}
+
+		/// @brief Names by relevance: closer prefix first, then shorter, then alphabetical
+		/// @param max_distance Edits allowed between the pattern and the beginning of the name
+		[[nodiscard]] std::vector<std::string> suggest(const std::string_view pattern, const std::size_t limit,
+		                                               const uint32_t max_distance) const
+		{
+			const std::u32string key = fold(pattern);
+			std::vector<std::string> result;
+			if (key.empty() || limit == 0)
+			{
+				return result;
+			}
+			Search search{key, max_distance, limit, {}, {}};
+			search.rows.resize(key.size() + 1);
+			for (std::size_t j = 0; j < search.rows.size(); ++j)
+			{
+				search.rows[j] = static_cast<uint32_t>(j);
+			}
+			for (const auto &[symbol, next]: nodes_.front().children)
+			{
+				if (can_improve(search, 0, nodes_[next].shortest))
+				{
+					walk(search, next, symbol, 1, static_cast<uint32_t>(key.size()));
+				}
+			}
+			std::ranges::sort(search.candidates);
+			result.reserve(search.candidates.size());
+			for (const auto &[distance, length, name]: search.candidates)
+			{
+				result.emplace_back(name);
+			}
+			return result;
+		}
+
+		/// @brief Number of distinct names
+		[[nodiscard]] std::size_t size() const
+		{
+			return size_;
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		/// @brief Code points of the UTF-8 text with latin and cyrillic letters in lower case.
+		/// Malformed bytes are kept as they are
+		[[nodiscard]] static std::u32string fold(const std::string_view text)
+		{
+			std::u32string result;
+			result.reserve(text.size());
+			for (std::size_t i = 0; i < text.size();)
+			{
+				const auto lead = static_cast<unsigned char>(text[i]);
+				const std::size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 :
+					                           (lead >> 3) == 0x1E ? 4 : 0;
+				char32_t symbol = lead;
+				if (length > 1 && i + length <= text.size())
+				{
+					symbol = lead & (0x7F >> length);
+					for (std::size_t k = 1; k < length; ++k)
+					{
+						symbol = symbol << 6 | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+					}
+					i += length;
+				}
+				else
+				{
+					++i;
+				}
+				if ((symbol >= U'A' && symbol <= U'Z') || (symbol >= U'А' && symbol <= U'Я'))
+				{
+					symbol += 0x20;
+				}
+				else if (symbol == U'Ё')
+				{
+					symbol = U'ё';
+				}
+				result.push_back(symbol);
+			}
+			return result;
+		}
+
+	private:
+		static constexpr uint32_t absent = UINT32_MAX;
+
+		struct Node
+		{
+			// Sorted by the symbol, most nodes have one or two children
+			std::vector<std::pair<char32_t, uint32_t>> children;
+			std::string name;
+			uint32_t references = 0;
+			// Length of the shortest name below the node. Not raised when names are removed, stays a lower bound
+			uint32_t shortest = absent;
+		};
+
+		// Distance of the prefix, length of the name and the name, in the order of relevance
+		using Candidate = std::tuple<uint32_t, std::size_t, std::string_view>;
+
+		struct Search
+		{
+			const std::u32string &key;
+			uint32_t max_distance;
+			std::size_t limit;
+			// Max-heap of the best candidates found so far
+			std::vector<Candidate> candidates;
+			// Levenshtein rows of the current path, one per depth, reused by all branches
+			std::vector<uint32_t> rows;
+		};
+
+		uint32_t child(const uint32_t node, const char32_t symbol, const bool create)
+		{
+			auto &children = nodes_[node].children;
+			const auto it = std::ranges::lower_bound(children, symbol, {}, &std::pair<char32_t, uint32_t>::first);
+			if (it != children.end() && it->first == symbol)
+			{
+				return it->second;
+			}
+			if (!create)
+			{
+				return absent;
+			}
+			const auto next = static_cast<uint32_t>(nodes_.size());
+			children.emplace(it, symbol, next);
+			nodes_.emplace_back();
+			return next;
+		}
+
+		/// @brief Row of the node holds distances between its prefix and each prefix of the key
+		/// @param best Smallest distance between the key and a prefix on the way to the node
+		void walk(Search &search, const uint32_t node, const char32_t symbol, const std::size_t depth,
+		          uint32_t best) const
+		{
+			const std::size_t width = search.key.size() + 1;
+			if (search.rows.size() < (depth + 1) * width)
+			{
+				search.rows.resize((depth + 1) * width);
+			}
+			const uint32_t *previous = search.rows.data() + (depth - 1) * width;
+			uint32_t *row = search.rows.data() + depth * width;
+			row[0] = previous[0] + 1;
+			uint32_t row_min = row[0];
+			for (std::size_t j = 1; j < width; ++j)
+			{
+				row[j] = std::min({
+					previous[j] + 1, row[j - 1] + 1, previous[j - 1] + (search.key[j - 1] == symbol ? 0u : 1u)
+				});
+				row_min = std::min(row_min, row[j]);
+			}
+			best = std::min(best, row[width - 1]);
+			if (best > search.max_distance && row_min > search.max_distance)
+			{
+				// Longer names only move away from the key
+				return;
+			}
+			const Node &current = nodes_[node];
+			if (current.references > 0 && best <= search.max_distance)
+			{
+				offer(search, Candidate{best, depth, current.name});
+			}
+			// Distances of the longer prefixes are not below the row, so it bounds every name of the branches
+			const uint32_t bound = std::min(best, row_min);
+			for (const auto &[next_symbol, next]: current.children)
+			{
+				if (!can_improve(search, bound, nodes_[next].shortest))
+				{
+					continue;
+				}
+				walk(search, next, next_symbol, depth + 1, best);
+			}
+		}
+
+		/// @return False if the heap is full and no name of the branch can get into it
+		static bool can_improve(const Search &search, const uint32_t distance, const std::size_t shortest)
+		{
+			const auto &heap = search.candidates;
+			return heap.size() < search.limit || Candidate{distance, shortest, {}} < heap.front();
+		}
+
+		static void offer(Search &search, const Candidate &candidate)
+		{
+			auto &heap = search.candidates;
+			if (heap.size() < search.limit)
+			{
+				heap.push_back(candidate);
+				std::ranges::push_heap(heap);
+			}
+			else if (candidate < heap.front())
+			{
+				std::ranges::pop_heap(heap);
+				heap.back() = candidate;
+				std::ranges::push_heap(heap);
+			}
+		}
+
+		std::vector<Node> nodes_ = std::vector<Node>(1);
+		std::size_t size_ = 0;
+	};
+} // namespace drug_lib::services
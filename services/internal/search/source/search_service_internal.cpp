@@ -5,148 +5,139 @@ namespace drug_lib::services
     SearchResponse
     SearchServiceInternal::search_through_all(const std::string& pattern)
     {
-        SearchResponse result;
-        std::vector<data::objects::Medicament> meds = handbook_.medicaments().search_paged(pattern, this->page_limit_);
-        std::vector<data::objects::Disease> diseases = handbook_.diseases().search_paged(pattern, this->page_limit_);
-        std::vector<data::objects::Organization> organizations =
-            handbook_.organizations().search_paged(pattern, this->page_limit_);
-        std::vector<data::objects::Patient> patients = handbook_.patients().search_paged(pattern, this->page_limit_);
-        result.add(std::move(patients), SearchResponse::PERFECT_MATCH);
-        result.add(std::move(meds), SearchResponse::PERFECT_MATCH);
-        result.add(std::move(diseases), SearchResponse::PERFECT_MATCH);
-        result.add(std::move(organizations), SearchResponse::PERFECT_MATCH);
-        return result;
+        std::vector<SubSearch> searches;
+        searches.push_back(exact_search<data::objects::Patient>(pattern));
+        searches.push_back(exact_search<data::objects::Medicament>(pattern));
+        searches.push_back(exact_search<data::objects::Disease>(pattern));
+        searches.push_back(exact_search<data::objects::Organization>(pattern));
+        return fan_out(std::move(searches));
     }
 
     SearchResponse
     SearchServiceInternal::open_search(const std::string& pattern)
     {
-        SearchResponse result;
-        std::vector<data::objects::Medicament> meds =
-            handbook_.medicaments().fuzzy_search_paged(pattern, this->page_limit_);
-        std::vector<data::objects::Disease> diseases =
-            handbook_.diseases().fuzzy_search_paged(pattern, this->page_limit_);
-        result.add(std::move(meds), SearchResponse::PARTIAL_MATCH);
-        result.add(std::move(diseases), SearchResponse::PARTIAL_MATCH);
+        std::vector<SubSearch> searches;
+        searches.push_back(fuzzy_search<data::objects::Medicament>(pattern));
+        searches.push_back(fuzzy_search<data::objects::Disease>(pattern));
+        SearchResponse result = fan_out(std::move(searches));
+        result.sort_by_relevance();
         return result;
     }
 
-    SearchResponse SearchServiceInternal::direct_search_medicaments(const std::string &pattern, const std::size_t page_number)
+    SearchResponse SearchServiceInternal::fan_out(std::vector<SubSearch>&& searches)
     {
-        std::cout << "SearchServiceInternal::direct_search_medicaments" << std::endl;
         SearchResponse result;
-        std::vector<data::objects::Medicament> perfect_medicaments = handbook_.medicaments().search_paged(pattern, this->page_limit_, page_number);
-        result.add(std::move(perfect_medicaments), SearchResponse::PERFECT_MATCH);
-        if (result.get().size() < page_limit_)
+        if (!fan_out_)
         {
-            std::vector<data::objects::Medicament> partial_medicaments =
-                    handbook_.medicaments().fuzzy_search_paged(pattern, page_limit_, page_number);
-            while (partial_medicaments.size() > result.get().size())
+            // All sessions share one connection, so the searches go out in one round-trip
+            auto handbook = handbooks_.session();
+            std::vector<common::database::interfaces::ViewQuery> queries;
+            queries.reserve(searches.size());
+            for (auto& search : searches)
+            {
+                queries.push_back(std::move(search.query));
+            }
+            const auto rows = handbook->medicaments().get_connection()->view_batch(queries);
+            for (std::size_t i = 0; i < searches.size(); ++i)
             {
-                result.add(std::move(partial_medicaments.back()), SearchResponse::PARTIAL_MATCH);
-                partial_medicaments.pop_back();
+                result.merge(searches[i].respond(rows[i]));
             }
-            result.add(std::move(partial_medicaments), SearchResponse::PARTIAL_MATCH);
+            return result;
         }
-        std::cerr << result.get().size() << std::endl;
-        return result;
-    }
-    SearchResponse
-    SearchServiceInternal::direct_search_diseases(const std::string& pattern, const std::size_t page_number)
-    {
-        SearchResponse result;
-        std::vector<data::objects::Disease> perfect_diseases = handbook_.diseases().search_paged(pattern, this->page_limit_, page_number);
-        result.add(std::move(perfect_diseases), SearchResponse::PERFECT_MATCH);
-        if (result.get().size() < page_limit_)
+        const auto deadline = std::chrono::steady_clock::now() + search_deadline_;
+        std::vector<std::future<std::optional<SearchResponse>>> responses;
+        responses.reserve(searches.size());
+        for (auto& search : searches)
         {
-            std::vector<data::objects::Disease> partial_diseases =
-                    handbook_.diseases().fuzzy_search_paged(pattern, page_limit_, page_number);
-            while (partial_diseases.size() > result.get().size())
+            // Search owns its query, it may outlive this call if it misses the deadline
+            responses.push_back(fan_out_->submit([this, deadline, search = std::move(search)]
             {
-                result.add(std::move(partial_diseases.back()), SearchResponse::PARTIAL_MATCH);
-                partial_diseases.pop_back();
-            }
-            result.add(std::move(partial_diseases), SearchResponse::PARTIAL_MATCH);
+                return search_until(search, deadline);
+            }));
         }
-        return result;
-    }
-    SearchResponse
-    SearchServiceInternal::direct_search_organizations(const std::string& pattern, const std::size_t page_number)
-    {
-        SearchResponse result;
-        std::vector<data::objects::Organization> perfect_organizations = handbook_.organizations().search_paged(pattern, this->page_limit_, page_number);
-        result.add(std::move(perfect_organizations), SearchResponse::PERFECT_MATCH);
-        if (result.get().size() < page_limit_)
+        for (auto& response : responses)
         {
-            std::vector<data::objects::Organization> partial_organizations =
-                    handbook_.organizations().fuzzy_search_paged(pattern, page_limit_, page_number);
-            while (partial_organizations.size() > result.get().size())
+            if (response.wait_until(deadline) != std::future_status::ready)
+            {
+                continue;
+            }
+            if (std::optional<SearchResponse> ready = response.get())
             {
-                result.add(std::move(partial_organizations.back()), SearchResponse::PARTIAL_MATCH);
-                partial_organizations.pop_back();
+                result.merge(std::move(ready.value()));
             }
-            result.add(std::move(partial_organizations), SearchResponse::PARTIAL_MATCH);
         }
         return result;
     }
 
-    SearchResponse
-    SearchServiceInternal::direct_search_patients(const std::string& pattern, const std::size_t page_number)
+    std::optional<SearchResponse> SearchServiceInternal::search_until(
+        const SubSearch& search, const std::chrono::steady_clock::time_point deadline) const
     {
-        SearchResponse result;
-        std::vector<data::objects::Patient> perfect_patients = handbook_.patients().search_paged(pattern, this->page_limit_, page_number);
-        result.add(std::move(perfect_patients), SearchResponse::PERFECT_MATCH);
-        if (result.get().size() < page_limit_)
+        auto handbook = handbooks_.session();
+        const auto connection = handbook->medicaments().get_connection();
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            // Waited for a worker or a connection past the deadline
+            return std::nullopt;
+        }
+        // Backend cancels the query at the deadline, so a late search doesn't hold the connection
+        connection->set_statement_timeout(remaining);
+        std::vector<std::unique_ptr<common::database::ViewRecord>> rows;
+        try
+        {
+            rows = connection->view(search.query.table_name, search.query.conditions);
+        }
+        catch (const std::exception&)
         {
-            std::vector<data::objects::Patient> partial_patients =
-                    handbook_.patients().fuzzy_search_paged(pattern, page_limit_, page_number);
-            while (partial_patients.size() > result.get().size())
+            connection->set_statement_timeout(std::chrono::milliseconds::zero());
+            if (std::chrono::steady_clock::now() >= deadline)
             {
-                result.add(std::move(partial_patients.back()), SearchResponse::PARTIAL_MATCH);
-                partial_patients.pop_back();
+                return std::nullopt;
             }
-            result.add(std::move(partial_patients), SearchResponse::PARTIAL_MATCH);
+            throw;
         }
-        return result;
+        connection->set_statement_timeout(std::chrono::milliseconds::zero());
+        return search.respond(rows);
     }
+
     std::vector<std::string> SearchServiceInternal::suggest(const std::string& pattern)
     {
-        this->suggest_temperature_ = 0;
-        throw std::logic_error("not implemented");
+        // Failed load leaves the flag unset, the next call tries again
+        std::call_once(suggestions_loaded_, [this] { refresh_suggestions(); });
+        std::shared_lock lock(suggestions_mutex_);
+        return suggestions_.suggest(pattern, page_limit_, suggest_distance(pattern));
+    }
+
+    void SearchServiceInternal::refresh_suggestions()
+    {
+        auto handbook = handbooks_.session();
+        SuggestIndex index;
+        // Patients aren't suggested, their names are personal data
+        const auto add_name = [&index](auto&& object) { index.add(object.get_name()); };
+        handbook->medicaments().for_each(add_name);
+        handbook->diseases().for_each(add_name);
+        handbook->organizations().for_each(add_name);
+        std::unique_lock lock(suggestions_mutex_);
+        suggestions_ = std::move(index);
     }
 
+    void SearchServiceInternal::add_suggestion(const std::string& name)
+    {
+        std::unique_lock lock(suggestions_mutex_);
+        suggestions_.add(name);
+    }
 
-    uint32_t SearchServiceInternal::editor_distance(const std::string& suggest, const std::string& pattern)
+    void SearchServiceInternal::remove_suggestion(const std::string& name)
     {
-        // Get lengths of both strings
-        const std::size_t m = suggest.size();
-        const std::size_t n = pattern.size();
+        std::unique_lock lock(suggestions_mutex_);
+        suggestions_.remove(name);
+    }
 
-        // Create a 2D DP table
-        std::vector dp(m + 1, std::vector<uint32_t>(n + 1));
-        for (size_t i = 0; i <= m; ++i)
-        {
-            for (size_t j = 0; j <= n; ++j)
-            {
-                if (i == 0)
-                {
-                    dp[i][j] = j;
-                }
-                else if (j == 0)
-                {
-                    dp[i][j] = i;
-                }
-                else if (suggest[i - 1] == pattern[j - 1])
-                {
-                    dp[i][j] = dp[i - 1][j - 1];
-                }
-                else
-                {
-                    dp[i][j] = 1 + std::min(std::min(dp[i - 1][j], dp[i][j - 1]), dp[i - 1][j - 1]);
-                }
-            }
-        }
-        return dp[m][n];
+    uint32_t SearchServiceInternal::suggest_distance(const std::string& pattern) const
+    {
+        const std::size_t length = SuggestIndex::fold(pattern).size();
+        const auto distance = static_cast<uint32_t>((length * suggest_temperature_ + 50) / 100);
+        return std::min(distance, max_suggest_distance);
     }
 
 } // namespace drug_lib::services
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "handbook_provider.hpp"
 #include "super_handbook.hpp"
 
 
@@ -39,25 +40,43 @@ namespace drug_lib::services
         MedicamentSuggestion suggest_medicament(const common::database::Uuid &patient_id);
         bool is_dangerous(common::database::Uuid patient_id);
 
+        /// @brief Serve repeated reads of medicaments and diseases from memory, see SuperHandbook::enable_reference_cache
+        void enable_cache(const dao::CacheSettings& settings = {})
+        {
+            handbooks_.configure([&settings](dao::SuperHandbook& handbook) { handbook.enable_reference_cache(settings); });
+        }
+
+        [[nodiscard]] dao::CacheMetrics medicaments_cache_metrics() const
+        {
+            return handbooks_.prototype().medicaments().cache_metrics();
+        }
+
+        [[nodiscard]] dao::CacheMetrics diseases_cache_metrics() const
+        {
+            return handbooks_.prototype().diseases().cache_metrics();
+        }
+
         void setup_from_one(const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
         {
-            handbook_.direct_establish(connect);
+            handbooks_.setup_from_one(connect);
         }
 
-        void pool_setup(common::database::creational::DbInterfacePool& pool)
+        /// @brief Each request leases own connection from the pool
+        void pool_setup(std::shared_ptr<common::database::creational::DbInterfacePool> pool)
         {
-            handbook_.establish_from_pool(pool);
+            handbooks_.setup_from_pool(std::move(pool));
         }
 
         explicit TreatmentManagerServiceInternal(
             const std::shared_ptr<common::database::interfaces::DbInterface>& connect)
         {
+            enable_cache();
             setup_from_one(connect);
         }
 
         TreatmentManagerServiceInternal() = default;
 
     private:
-        dao::SuperHandbook handbook_;
+        dao::HandbookProvider<dao::SuperHandbook> handbooks_;
     };
 }
@@ -7,28 +7,31 @@
 void drug_lib::services::TreatmentManagerServiceInternal::assign_disease(
 	common::database::Uuid patient_id, common::database::Uuid disease_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
 	const std::shared_ptr<data::objects::patients::CurrentDiseases> cur_diseases = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentDiseases>(
 		persona.get_property(data::objects::patients::properties::current_diseases));
 	cur_diseases->push_back(std::move(disease_id));
-	handbook_.patients().force_insert(persona);
+	handbook->patients().force_insert(persona);
 }
 
 void drug_lib::services::TreatmentManagerServiceInternal::assign_medicament(common::database::Uuid patient_id, common::database::Uuid drug_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
 	const std::shared_ptr<data::objects::patients::CurrentMedicaments> cur_drugs = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentMedicaments>(
 		persona.get_property(data::objects::patients::properties::current_medicaments));
 	cur_drugs->push_back(std::move(drug_id));
-	handbook_.patients().force_insert(persona);
+	handbook->patients().force_insert(persona);
 }
 
 void drug_lib::services::TreatmentManagerServiceInternal::remove_disease(
 	common::database::Uuid patient_id, const common::database::Uuid &disease_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
 	const std::shared_ptr<data::objects::patients::CurrentDiseases> cur_diseases = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentDiseases>(
 		persona.get_property(data::objects::patients::properties::current_diseases));
@@ -37,12 +40,13 @@ void drug_lib::services::TreatmentManagerServiceInternal::remove_disease(
 	{
 		return it == disease_id;
 	});
-	handbook_.patients().force_insert(persona);
+	handbook->patients().force_insert(persona);
 }
 
 void drug_lib::services::TreatmentManagerServiceInternal::remove_medicament(common::database::Uuid patient_id, const common::database::Uuid &drug_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
 	const std::shared_ptr<data::objects::patients::CurrentMedicaments> cur_drugs = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentMedicaments>(
 		persona.get_property(data::objects::patients::properties::current_medicaments));
@@ -51,14 +55,15 @@ void drug_lib::services::TreatmentManagerServiceInternal::remove_medicament(comm
 	{
 		return it == drug_id;
 	});
-	handbook_.patients().force_insert(persona);
+	handbook->patients().force_insert(persona);
 }
 
 void drug_lib::services::TreatmentManagerServiceInternal::cure_disease(
 	common::database::Uuid patient_id,
 	const common::database::Uuid &disease_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
 	const std::shared_ptr<data::objects::patients::CurrentDiseases> cur_diseases = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentDiseases>(
 		persona.get_property(data::objects::patients::properties::current_diseases));
@@ -97,50 +102,42 @@ void drug_lib::services::TreatmentManagerServiceInternal::cure_disease(
 		it->set_end_date(current_date);
 		it->set_current(false);
 	}
-	handbook_.patients().force_insert(persona);
+	handbook->patients().force_insert(persona);
 }
 
 std::vector<drug_lib::data::objects::Medicament> drug_lib::services::TreatmentManagerServiceInternal::current_medicaments(
 	common::database::Uuid patient_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
-	std::vector medicament_indexes = std::dynamic_pointer_cast<
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
+	const std::vector medicament_indexes = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentMedicaments>(
 		persona.get_property(data::objects::patients::properties::current_medicaments))->get_data();
-	std::vector<data::objects::Medicament> result;
-	result.reserve(medicament_indexes.size());
-	for (auto &&ids: medicament_indexes)
-	{
-		result.emplace_back(std::move(handbook_.medicaments().get_by_id(std::move(ids))));
-	}
-	return result;
+	return handbook->medicaments().get_by_ids(medicament_indexes);
 }
 
 std::vector<drug_lib::data::objects::Disease> drug_lib::services::TreatmentManagerServiceInternal::current_diseases(
 	common::database::Uuid patient_id)
 {
-	const data::objects::Patient persona = handbook_.patients().get_by_id(std::move(patient_id));
-	std::vector<common::database::Uuid> disease_indexes = std::dynamic_pointer_cast<
+	auto handbook = handbooks_.session();
+	const data::objects::Patient persona = handbook->patients().get_by_id(std::move(patient_id));
+	const std::vector<common::database::Uuid> disease_indexes = std::dynamic_pointer_cast<
 		data::objects::patients::CurrentDiseases>(
 		persona.get_property(data::objects::patients::properties::current_diseases))->get_data();
-	std::vector<data::objects::Disease> result;
-	result.reserve(disease_indexes.size());
-	for (auto &&ids: disease_indexes)
-	{
-		result.emplace_back(std::move(handbook_.diseases().get_by_id(std::move(ids))));
-	}
-	return result;
+	return handbook->diseases().get_by_ids(disease_indexes);
 }
 
 drug_lib::data::objects::Patient drug_lib::services::TreatmentManagerServiceInternal::patient_profile(
 	common::database::Uuid patient_id)
 {
-	return handbook_.patients().get_by_id(std::move(patient_id));
+	auto handbook = handbooks_.session();
+	return handbook->patients().get_by_id(std::move(patient_id));
 }
 
 bool drug_lib::services::TreatmentManagerServiceInternal::is_dangerous(common::database::Uuid patient_id)
 {
-	return handbook_.patients().get_by_id(std::move(patient_id)).get_gender() == "Female";
+	auto handbook = handbooks_.session();
+	return handbook->patients().get_by_id(std::move(patient_id)).get_gender() == "Female";
 }
 
 drug_lib::services::TreatmentManagerServiceInternal::MedicamentSuggestion drug_lib::services::TreatmentManagerServiceInternal::suggest_medicament(const common::database::Uuid &patient_id)
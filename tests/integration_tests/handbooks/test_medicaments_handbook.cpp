@@ -0,0 +1,79 @@
+// test_medicaments_handbook.cpp
+
+#include <array>
+#include <db_interface_factory.hpp>
+#include <gtest/gtest.h>
+
+#include "medicaments_handbook.hpp"
+using namespace drug_lib::common::database;
+using drug_lib::data::objects::Medicament;
+
+class MedicamentsHandbookTest : public testing::Test
+{
+protected:
+    // Database connection parameters
+    //
+    static constexpr auto port = 5432;
+    static constexpr auto host = "localhost";
+    static constexpr auto db_name = "test_db";
+    static constexpr auto username = "postgres";
+    static constexpr auto password = "postgres"; // Replace it with your actual password
+
+    static constexpr auto aspirin_id = "5b2c7f1e-8a4d-4c3b-9e6f-0a1b2c3d4e5f";
+    static constexpr auto ibuprofen_id = "0d9e8f7a-6b5c-4d3e-8f2a-1b0c9d8e7f6a";
+
+    std::shared_ptr<interfaces::DbInterface> db_client_;
+    drug_lib::dao::MedicamentsHandbook handbook_;
+
+    void SetUp() override
+    {
+        db_client_ = creational::DbInterfaceFactory::create_pqxx_client({host, port, db_name, username, password});
+        handbook_.set_connection(db_client_);
+        handbook_.remove_all();
+        handbook_.insert(Medicament(Uuid(aspirin_id, true), "Aspirin", "Tablet", false, "A-1", "Approved", "N02BA01"));
+        handbook_.insert(
+            Medicament(Uuid(ibuprofen_id, true), "Ibuprofen", "Tablet", false, "I-1", "Approved", "M01AE01"));
+    }
+
+    void TearDown() override
+    {
+        handbook_.remove_all();
+    }
+};
+
+TEST_F(MedicamentsHandbookTest, CanonicalIdTest)
+{
+    EXPECT_EQ(Uuid("5B2C7F1E-8A4D-4C3B-9E6F-0A1B2C3D4E5F", false).canonical_id(), aspirin_id);
+    EXPECT_EQ(Uuid("{5b2c7f1e8a4d4c3b9e6f0a1b2c3d4e5f}", false).canonical_id(), aspirin_id);
+    EXPECT_EQ(Uuid("not-a-uuid", false).canonical_id(), "not-a-uuid");
+}
+
+// Ids are matched to the rows and cached regardless of the case they are spelled in
+TEST_F(MedicamentsHandbookTest, GetByIdsMixedCaseTest)
+{
+    const std::array ids{
+        Uuid("5B2C7F1E-8A4D-4C3B-9E6F-0A1B2C3D4E5F", false),
+        Uuid(ibuprofen_id, false),
+        Uuid(aspirin_id, false)
+    };
+    std::vector<Medicament> medicaments;
+    ASSERT_NO_THROW(medicaments = handbook_.get_by_ids(ids));
+    ASSERT_EQ(medicaments.size(), 3);
+    EXPECT_EQ(medicaments[0].get_name(), "Aspirin");
+    EXPECT_EQ(medicaments[1].get_name(), "Ibuprofen");
+    EXPECT_EQ(medicaments[2].get_name(), "Aspirin");
+
+    handbook_.enable_cache();
+    EXPECT_EQ(handbook_.get_by_id(Uuid("5B2C7F1E-8A4D-4C3B-9E6F-0A1B2C3D4E5F", false)).get_name(), "Aspirin");
+    ASSERT_NO_THROW(medicaments = handbook_.get_by_ids(ids));
+    EXPECT_EQ(medicaments[0].get_name(), "Aspirin");
+    // Both spellings of aspirin are served by the entry cached under the upper case one
+    EXPECT_EQ(handbook_.cache_metrics().hits, 2);
+    EXPECT_EQ(handbook_.cache_metrics().size, 2);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
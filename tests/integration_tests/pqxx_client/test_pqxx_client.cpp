@@ -1,7 +1,10 @@
 // pqxx_client_test.cpp
 
+#include <algorithm>
 #include <barrier>
 #include <chrono>
+#include <numeric>
+#include <set>
 #include <db_interface_factory.hpp>
 #include <gtest/gtest.h>
 #include <trantor/utils/Logger.h>
@@ -317,6 +320,153 @@ TEST_F(PqxxClientTest, UpsertTestPartial)
     EXPECT_EQ(description, "Alice Updated");
 }
 
+TEST_F(PqxxClientTest, AnyValueConditionTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 20; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", i % 2 ? "Odd \"name\"" : "Even, name"));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    std::vector<std::unique_ptr<FieldBase>> ids;
+    for (const int id: {3, 7, 11, 42})
+    {
+        ids.push_back(std::make_unique<Field<int32_t>>("", id));
+    }
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), std::move(ids)));
+    const auto res = db_client_->select(test_table_, conditions);
+    std::set<int32_t> found;
+    for (const auto &record: res)
+    {
+        found.insert(record[0]->as<int32_t>());
+    }
+    EXPECT_EQ(found, std::set<int32_t>({3, 7, 11}));
+
+    // Quotes and commas of the values are escaped inside the array
+    std::vector<std::unique_ptr<FieldBase>> names;
+    names.push_back(std::make_unique<Field<std::string>>("", "Odd \"name\""));
+    names.push_back(std::make_unique<Field<std::string>>("", "Even, name"));
+    Conditions names_conditions;
+    names_conditions.add_field_condition(FieldCondition(std::make_unique<Field<std::string>>("name", ""),
+                                                        std::move(names)));
+    EXPECT_EQ(db_client_->count(test_table_, names_conditions), 20);
+}
+
+TEST_F(PqxxClientTest, DecodeFieldTypesTest)
+{
+    const std::string table = "decode_types_table";
+    const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+    Json::Value json;
+    json["name"] = "Aspirin";
+    json["doses"].append(100);
+
+    auto make_record = [&]
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int64_t>>("big", int64_t{1} << 40));
+        record.push_back(std::make_unique<Field<double>>("real", 2.5));
+        record.push_back(std::make_unique<Field<bool>>("flag", true));
+        record.push_back(std::make_unique<Field<Json::Value>>("data", json));
+        record.push_back(std::make_unique<Field<std::chrono::system_clock::time_point>>("created", now));
+        return record;
+    };
+    if (db_client_->check_table(table))
+    {
+        db_client_->remove_table(table);
+    }
+    db_client_->create_table(table, make_record());
+    std::vector<Record> records;
+    records.push_back(make_record());
+    EXPECT_NO_THROW(db_client_->insert(table, records));
+
+    const auto res = db_client_->select(table);
+    ASSERT_EQ(res.size(), 1);
+    EXPECT_EQ(res[0][0]->as<int64_t>(), int64_t{1} << 40);
+    EXPECT_DOUBLE_EQ(res[0][1]->as<double>(), 2.5);
+    EXPECT_TRUE(res[0][2]->as<bool>());
+    EXPECT_EQ(res[0][3]->as<Json::Value>(), json);
+    EXPECT_EQ(res[0][4]->as<std::chrono::system_clock::time_point>(), now);
+    db_client_->remove_table(table);
+}
+
+TEST_F(PqxxClientTest, BinaryJsonbTest)
+{
+    const std::string table = "binary_jsonb_table";
+    PqxxConnectParams params{host, port, db_name, username, password};
+    params.set_binary_jsonb(true);
+    const auto client = creational::DbInterfaceFactory::create_pqxx_client(params);
+    Json::Value json;
+    json["name"] = "Quote \" and \\ slash";
+    json["doses"].append(100);
+    json["nested"]["flag"] = true;
+
+    auto make_record = [&](const int id, const Json::Value& data)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", id));
+        record.push_back(std::make_unique<Field<Json::Value>>("data", data));
+        return record;
+    };
+    if (client->check_table(table))
+    {
+        client->remove_table(table);
+    }
+    client->create_table(table, make_record(0, json));
+    client->make_unique_constraint(table, {std::make_shared<Field<int>>("id", 0)});
+    std::vector<Record> records;
+    records.push_back(make_record(1, json));
+    EXPECT_NO_THROW(client->insert(table, records));
+
+    Json::Value updated = json;
+    updated["doses"].append(200);
+    records.clear();
+    records.push_back(make_record(1, updated));
+    records.push_back(make_record(2, json));
+    EXPECT_NO_THROW(client->upsert(table, records, {std::make_shared<Field<Json::Value>>("data", Json::Value())}));
+
+    Conditions conditions;
+    conditions.add_order_by_condition(OrderCondition("id", order_type::ascending));
+    const auto res = client->select(table, conditions);
+    ASSERT_EQ(res.size(), 2);
+    EXPECT_EQ(res[0][1]->as<Json::Value>(), updated);
+    EXPECT_EQ(res[1][1]->as<Json::Value>(), json);
+    client->remove_table(table);
+}
+
+TEST_F(PqxxClientTest, ColumnarSelectTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 100; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "name_" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    const auto all = db_client_->select_columns(test_table_);
+    ASSERT_EQ(all.rows(), 100);
+    // Stored search vector isn't selected
+    EXPECT_EQ(all.columns_count(), 3);
+    const auto ids = all.column("id").integers();
+    EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), int64_t{0}), 5050);
+
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), "=",
+                                                  std::make_unique<Field<int32_t>>("", 42)));
+    const auto one = db_client_->select_columns(test_table_, conditions);
+    ASSERT_EQ(one.rows(), 1);
+    EXPECT_EQ(one.column("name").text(0), "name_42");
+}
+
 TEST_F(PqxxClientTest, RemoveTest)
 {
     // Add data
@@ -384,6 +534,43 @@ TEST_F(PqxxClientTest, CountAllTest)
     EXPECT_EQ(count_all, 5);
 }
 
+TEST_F(PqxxClientTest, EstimateCountTest)
+{
+    std::vector<Record> records;
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    // Statistics are refreshed by hand, the client doesn't expose ANALYZE
+    pqxx::connection analyzer(PqxxConnectParams{host, port, db_name, username, password}.make_connect_string());
+    const auto analyze = [&]
+    {
+        pqxx::nontransaction(analyzer).exec("ANALYZE " + analyzer.quote_name(test_table_));
+    };
+
+    // Small table is sampled completely, the estimate is exact
+    analyze();
+    EXPECT_EQ(db_client_->estimate_count(test_table_), 1000);
+
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), ">",
+                                                  std::make_unique<Field<int32_t>>("", 400)));
+    EXPECT_NO_THROW(db_client_->remove(test_table_, conditions));
+    ASSERT_EQ(db_client_->count(test_table_), 400);
+
+    // Estimate follows the rows left once the statistics are refreshed
+    analyze();
+    EXPECT_EQ(db_client_->estimate_count(test_table_), 400);
+}
+
 TEST_F(PqxxClientTest, FullTextSearchTest)
 {
     // Add data to the table
@@ -450,6 +637,152 @@ TEST_F(PqxxClientTest, FullTextSearchTest)
     EXPECT_TRUE(results.empty());
 }
 
+TEST_F(PqxxClientTest, RankedSearchTest)
+{
+    std::vector<Record> records;
+    const std::vector<std::pair<std::string, std::string>> data = {
+        {"Melon", "A fruit"}, {"Fruit salad", "Fruit and more fruit, fruit only"}, {"Lemon", "A sour fruit fruit"}
+    };
+    for (int i = 0; i < static_cast<int>(data.size()); ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i + 1));
+        record.push_back(std::make_unique<Field<std::string>>("name", data[i].first));
+        record.push_back(std::make_unique<Field<std::string>>("description", data[i].second));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    Conditions conditions;
+    conditions.add_pattern_condition(PatternCondition("fruit"));
+    conditions.set_pattern_ranking(true);
+    const auto results = db_client_->select(test_table_, conditions);
+    ASSERT_EQ(results.size(), 3);
+    // Stored search vector isn't a part of the records
+    EXPECT_EQ(results.front().size(), 3);
+    EXPECT_EQ(results[0][0]->as<int32_t>(), 2);
+    EXPECT_EQ(results[1][0]->as<int32_t>(), 3);
+    EXPECT_EQ(results[2][0]->as<int32_t>(), 1);
+
+    // Without stored vector the document is computed per row, declaring fields migrates the table back
+    EXPECT_NO_THROW(db_client_->remove_search_index(test_table_));
+    EXPECT_EQ(db_client_->select(test_table_).front().size(), 3);
+    std::vector<std::shared_ptr<FieldBase>> fts_fields;
+    fts_fields.emplace_back(std::make_shared<Field<std::string>>("name", ""));
+    fts_fields.emplace_back(std::make_shared<Field<std::string>>("description", ""));
+    EXPECT_NO_THROW(db_client_->set_search_fields(test_table_, std::move(fts_fields)));
+    const auto migrated = db_client_->view(test_table_, conditions);
+    ASSERT_EQ(migrated.size(), 3);
+    EXPECT_EQ(migrated.front()->size(), 3);
+    EXPECT_NO_THROW(db_client_->restore_search_index(test_table_));
+    EXPECT_EQ(db_client_->select(test_table_, conditions).size(), 3);
+}
+
+// Stored search vector follows the declared fields, the old document isn't searched after the change
+TEST_F(PqxxClientTest, SearchFieldsChangeTest)
+{
+    std::vector<Record> records;
+    const std::vector<std::pair<std::string, std::string>> data = {
+        {"Melon", "A fruit"}, {"Fruit salad", "Mixed"}, {"Lemon", "Sour"}
+    };
+    for (int i = 0; i < static_cast<int>(data.size()); ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i + 1));
+        record.push_back(std::make_unique<Field<std::string>>("name", data[i].first));
+        record.push_back(std::make_unique<Field<std::string>>("description", data[i].second));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    Conditions conditions;
+    conditions.add_pattern_condition(PatternCondition("fruit"));
+    EXPECT_EQ(db_client_->select(test_table_, conditions).size(), 2);
+
+    std::vector<std::shared_ptr<FieldBase>> name_only;
+    name_only.emplace_back(std::make_shared<Field<std::string>>("name", ""));
+    EXPECT_NO_THROW(db_client_->set_search_fields(test_table_, std::move(name_only)));
+    const auto by_name = db_client_->select(test_table_, conditions);
+    ASSERT_EQ(by_name.size(), 1);
+    EXPECT_EQ(by_name.front()[0]->as<int32_t>(), 2);
+    EXPECT_EQ(by_name.front().size(), 3);
+
+    // Same fields again keep the column, the other client sees the new document too
+    std::vector<std::shared_ptr<FieldBase>> same;
+    same.emplace_back(std::make_shared<Field<std::string>>("name", ""));
+    EXPECT_NO_THROW(db_client_->set_search_fields(test_table_, std::move(same)));
+    const auto other_client =
+        creational::DbInterfaceFactory::create_pqxx_client({host, port, db_name, username, password});
+    std::vector<std::shared_ptr<FieldBase>> other_fields;
+    other_fields.emplace_back(std::make_shared<Field<std::string>>("name", ""));
+    other_client->set_search_fields(test_table_, std::move(other_fields));
+    EXPECT_EQ(other_client->select(test_table_, conditions).size(), 1);
+}
+
+TEST_F(PqxxClientTest, RelevanceSearchTest)
+{
+    std::vector<Record> records;
+    const std::vector<std::pair<std::string, std::string>> data = {
+        {"Aspirine", "Tablets"}, {"Carrot", "Vegetable"}, {"Aspirin", "Pain relief"}
+    };
+    for (int i = 0; i < static_cast<int>(data.size()); ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i + 1));
+        record.push_back(std::make_unique<Field<std::string>>("name", data[i].first));
+        record.push_back(std::make_unique<Field<std::string>>("description", data[i].second));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    auto make_conditions = [](const int32_t page_limit, const int32_t page_number)
+    {
+        Conditions conditions;
+        conditions.set_relevance_condition(RelevanceCondition("aspirin"));
+        conditions.add_order_by_condition(OrderCondition("id"));
+        conditions.set_page_condition(PageCondition(page_limit).set_page_number(page_number));
+        return conditions;
+    };
+    // Exact match goes first, the similar one follows, unrelated rows are filtered out
+    const auto results = db_client_->select(test_table_, make_conditions(10, 1));
+    ASSERT_EQ(results.size(), 2);
+    ASSERT_EQ(results.front().size(), 5);
+    EXPECT_EQ(results[0][0]->as<int32_t>(), 3);
+    EXPECT_TRUE(results[0][4]->as<bool>());
+    EXPECT_EQ(results[1][0]->as<int32_t>(), 1);
+    EXPECT_FALSE(results[1][4]->as<bool>());
+    EXPECT_GT(results[0][3]->as<double>(), results[1][3]->as<double>());
+
+    // Pages follow the same order
+    const auto second_page = db_client_->view(test_table_, make_conditions(1, 2));
+    ASSERT_EQ(second_page.size(), 1);
+    EXPECT_EQ(second_page[0]->view(0), "1");
+    EXPECT_TRUE(db_client_->view(test_table_, make_conditions(1, 3)).empty());
+}
+
+TEST_F(PqxxClientTest, RelevanceSimilarityThresholdTest)
+{
+    // Trigram similarity to "aspirin": Asprin 0.5, Aspen 0.27, Carrot 0
+    std::vector<Record> records;
+    const std::vector<std::string> names = {"Asprin", "Aspen", "Carrot"};
+    for (int i = 0; i < static_cast<int>(names.size()); ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i + 1));
+        record.push_back(std::make_unique<Field<std::string>>("name", names[i]));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, std::move(records)));
+
+    Conditions conditions;
+    conditions.set_relevance_condition(RelevanceCondition("aspirin"));
+    // Rows below the default pg_trgm.similarity_threshold of 0.3 are not similar
+    const auto results = db_client_->view(test_table_, conditions);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results.front()->view(1), "Asprin");
+}
+
 TEST_F(PqxxClientTest, SimilaritySearchTest)
 {
     // Add data to the table
@@ -720,6 +1053,402 @@ TEST_F(PqxxClientTest, PagingTest)
     EXPECT_EQ(res.size(), 50);
 }
 
+TEST_F(PqxxClientTest, SeekPagingTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 500; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        // Relevance grows with the id: description repeats the word id % 4 + 1 times
+        std::string description;
+        for (int j = 0; j <= i % 4; ++j)
+        {
+            description += "pers ";
+        }
+        record.push_back(std::make_unique<Field<std::string>>("description", description));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    auto walk = [this](const bool ranked)
+    {
+        std::vector<int32_t> ids;
+        std::unique_ptr<FieldBase> after;
+        std::optional<double> after_rank;
+        while (true)
+        {
+            Conditions conditions;
+            conditions.add_pattern_condition(PatternCondition("pers"));
+            conditions.set_pattern_ranking(ranked);
+            conditions.set_seek_condition(SeekCondition(std::make_unique<Field<int32_t>>("id", 0), std::move(after),
+                                                        150, after_rank));
+            const auto page = db_client_->select(test_table_, conditions);
+            for (const auto &record: page)
+            {
+                ids.push_back(record[0]->as<int32_t>());
+            }
+            if (page.size() < 150)
+            {
+                return ids;
+            }
+            after = std::make_unique<Field<int32_t>>("", ids.back());
+            if (ranked)
+            {
+                // Rank of the row is the trailing column
+                after_rank = page.back()[page.back().size() - 1]->as<double>();
+            }
+        }
+    };
+    const auto ids = walk(false);
+    ASSERT_EQ(ids.size(), 500);
+    EXPECT_TRUE(std::ranges::is_sorted(ids));
+
+    // Ranked pages keep the order of relevance and then key, rows aren't lost or repeated on the page borders
+    const auto ranked_ids = walk(true);
+    ASSERT_EQ(ranked_ids.size(), 500);
+    EXPECT_EQ(std::set(ranked_ids.begin(), ranked_ids.end()).size(), 500);
+    EXPECT_TRUE(std::ranges::is_sorted(ranked_ids, [](const int32_t lhs, const int32_t rhs)
+    {
+        return lhs % 4 != rhs % 4 ? lhs % 4 > rhs % 4 : lhs < rhs;
+    }));
+
+    Conditions invalid;
+    invalid.set_page_condition(PageCondition(10));
+    invalid.set_seek_condition(SeekCondition(std::make_unique<Field<int32_t>>("id", 0), nullptr, 10));
+    EXPECT_THROW(db_client_->view(test_table_, invalid), exceptions::QueryException);
+
+    Conditions without_rank;
+    without_rank.add_pattern_condition(PatternCondition("pers"));
+    without_rank.set_pattern_ranking(true);
+    without_rank.set_seek_condition(SeekCondition(std::make_unique<Field<int32_t>>("id", 0),
+                                                  std::make_unique<Field<int32_t>>("", 1), 10));
+    EXPECT_THROW(db_client_->view(test_table_, without_rank), exceptions::QueryException);
+}
+
+TEST_F(PqxxClientTest, SeekPagingDeletedAnchorTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 40; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", i % 2 == 0 ? "pers pers" : "pers"));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, std::move(records)));
+
+    auto page_after = [this](std::unique_ptr<FieldBase> after, const std::optional<double> after_rank)
+    {
+        Conditions conditions;
+        conditions.add_pattern_condition(PatternCondition("pers"));
+        conditions.set_pattern_ranking(true);
+        conditions.set_seek_condition(SeekCondition(std::make_unique<Field<int32_t>>("id", 0), std::move(after), 10,
+                                                    after_rank));
+        return db_client_->select(test_table_, conditions);
+    };
+    const auto first = page_after(nullptr, std::nullopt);
+    ASSERT_EQ(first.size(), 10);
+    const int32_t anchor = first.back()[0]->as<int32_t>();
+    const double anchor_rank = first.back()[first.back().size() - 1]->as<double>();
+
+    Conditions removed;
+    removed.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), "=",
+                                               std::make_unique<Field<int32_t>>("", anchor)));
+    db_client_->remove(test_table_, removed);
+
+    // Page continues after the deleted anchor as if it were there
+    const auto second = page_after(std::make_unique<Field<int32_t>>("", anchor), anchor_rank);
+    ASSERT_EQ(second.size(), 10);
+    EXPECT_EQ(second.front()[0]->as<int32_t>(), anchor + 2);
+}
+
+TEST_F(PqxxClientTest, PreparedStatementsCacheTest)
+{
+    const auto pqxx_client = std::dynamic_pointer_cast<PqxxClient>(db_client_);
+    ASSERT_NE(pqxx_client, nullptr);
+    std::vector<Record> records;
+    for (int i = 1; i <= 50; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, records));
+
+    const auto before = pqxx_client->get_prepared_statements_stats();
+    for (int i = 1; i <= 10; ++i)
+    {
+        Conditions conditions;
+        conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), "=",
+                                                      std::make_unique<Field<int32_t>>("", i)));
+        const auto res = db_client_->select(test_table_, conditions);
+        ASSERT_EQ(res.size(), 1);
+        EXPECT_EQ(res.front()[0]->as<int32_t>(), i);
+    }
+    // Different pages have the same shape
+    for (uint32_t page = 1; page <= 5; ++page)
+    {
+        Conditions conditions;
+        conditions.set_page_condition(PageCondition(10).set_page_number(page));
+        EXPECT_EQ(db_client_->view(test_table_, conditions).size(), 10);
+    }
+    const auto after = pqxx_client->get_prepared_statements_stats();
+    // Two query shapes, each is prepared at most once
+    EXPECT_EQ(after.hits + after.misses - before.hits - before.misses, 15);
+    EXPECT_LE(after.misses - before.misses, 2);
+    EXPECT_LE(after.size - before.size, 2);
+
+    // Now both shapes are prepared
+    for (int i = 1; i <= 10; ++i)
+    {
+        Conditions conditions;
+        conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), "=",
+                                                      std::make_unique<Field<int32_t>>("", i)));
+        EXPECT_EQ(db_client_->select(test_table_, conditions).size(), 1);
+    }
+    const auto again = pqxx_client->get_prepared_statements_stats();
+    EXPECT_EQ(again.misses - after.misses, 0);
+    EXPECT_EQ(again.hits - after.hits, 10);
+
+    pqxx_client->reset_prepared_statements();
+    EXPECT_EQ(pqxx_client->get_prepared_statements_stats().size, 0);
+}
+
+TEST_F(PqxxClientTest, PreparedStatementsAfterSchemaChangeTest)
+{
+    const std::string table = "prepared_schema_table";
+    const auto other = creational::DbInterfaceFactory::create_pqxx_client({host, port, db_name, username, password});
+    if (db_client_->check_table(table))
+    {
+        db_client_->remove_table(table);
+    }
+    Record fields;
+    fields.push_back(std::make_unique<Field<int>>("id", 0));
+    fields.push_back(std::make_unique<Field<std::string>>("name", ""));
+    db_client_->create_table(table, fields);
+    std::vector<Record> first(1);
+    first.front().push_back(std::make_unique<Field<int>>("id", 1));
+    first.front().push_back(std::make_unique<Field<std::string>>("name", "first"));
+    db_client_->insert(table, std::move(first));
+    // Other connection prepares SELECT * against two columns
+    const auto before = other->select(table);
+    ASSERT_EQ(before.size(), 1);
+    EXPECT_EQ(before.front().size(), 2);
+
+    db_client_->remove_table(table);
+    fields.push_back(std::make_unique<Field<std::string>>("description", ""));
+    db_client_->create_table(table, fields);
+    std::vector<Record> second(1);
+    second.front().push_back(std::make_unique<Field<int>>("id", 2));
+    second.front().push_back(std::make_unique<Field<std::string>>("name", "second"));
+    second.front().push_back(std::make_unique<Field<std::string>>("description", "text"));
+    db_client_->insert(table, std::move(second));
+
+    std::vector<Record> after;
+    EXPECT_NO_THROW(after = other->select(table));
+    ASSERT_EQ(after.size(), 1);
+    EXPECT_EQ(after.front().size(), 3);
+    db_client_->remove_table(table);
+}
+
+TEST_F(PqxxClientTest, BulkLoadTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 300; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "Name with 'quotes'\t" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", "Pers" + std::to_string(i % 3)));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->bulk_load(test_table_, records));
+    EXPECT_EQ(db_client_->count(test_table_), 300);
+
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<int32_t>>("id", 0), "=",
+                                                  std::make_unique<Field<int32_t>>("", 42)));
+    const auto res = db_client_->select(test_table_, conditions);
+    ASSERT_EQ(res.size(), 1);
+    EXPECT_EQ(res.front()[1]->as<std::string>(), "Name with 'quotes'\t42");
+
+    // Duplicated keys are skipped, the rest of the pack is loaded
+    for (int i = 301; i <= 350; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "New" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->bulk_load(test_table_, std::move(records)));
+    EXPECT_EQ(db_client_->count(test_table_), 350);
+    const auto kept = db_client_->select(test_table_, conditions);
+    ASSERT_EQ(kept.size(), 1);
+    EXPECT_EQ(kept.front()[1]->as<std::string>(), "Name with 'quotes'\t42");
+    EXPECT_THROW(db_client_->bulk_load(test_table_, std::vector<Record>{}), exceptions::QueryException);
+}
+
+// Generated column is left to the table only if every record leaves it default, in any order of the records
+TEST_F(PqxxClientTest, BulkLoadDefaultUuidTest)
+{
+    const auto make_record = [](Uuid id, const std::string &name)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<Uuid>>("id", std::move(id)));
+        record.push_back(std::make_unique<Field<std::string>>("name", name));
+        record.push_back(std::make_unique<Field<std::string>>("description", ""));
+        return record;
+    };
+    db_client_->remove_table(test_table_);
+    db_client_->create_table(test_table_, make_record(Uuid(), ""));
+
+    const std::string explicit_id = "550e8400-e29b-41d4-a716-446655440001";
+    std::vector<Record> default_first;
+    default_first.push_back(make_record(Uuid(), "Alice"));
+    default_first.push_back(make_record(Uuid(explicit_id, true), "Bob"));
+    EXPECT_THROW(db_client_->bulk_load(test_table_, std::move(default_first)), exceptions::QueryException);
+
+    std::vector<Record> explicit_first;
+    explicit_first.push_back(make_record(Uuid(explicit_id, true), "Bob"));
+    explicit_first.push_back(make_record(Uuid(), "Alice"));
+    EXPECT_THROW(db_client_->bulk_load(test_table_, std::move(explicit_first)), exceptions::QueryException);
+    EXPECT_EQ(db_client_->count(test_table_), 0);
+
+    std::vector<Record> generated;
+    generated.push_back(make_record(Uuid(), "Alice"));
+    generated.push_back(make_record(Uuid(), "Carol"));
+    EXPECT_NO_THROW(db_client_->bulk_load(test_table_, std::move(generated)));
+    std::vector<Record> given;
+    given.push_back(make_record(Uuid(explicit_id, true), "Bob"));
+    EXPECT_NO_THROW(db_client_->bulk_load(test_table_, std::move(given)));
+    EXPECT_EQ(db_client_->count(test_table_), 3);
+
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<Uuid>>("id", Uuid()), "=",
+                                                  std::make_unique<Field<Uuid>>("", Uuid(explicit_id, false))));
+    const auto res = db_client_->select(test_table_, conditions);
+    ASSERT_EQ(res.size(), 1);
+    EXPECT_EQ(res.front()[1]->as<std::string>(), "Bob");
+}
+
+TEST_F(PqxxClientTest, StreamCursorTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 250; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", "Pers" + std::to_string(i % 2)));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, std::move(records)));
+
+    {
+        const auto cursor = db_client_->stream(test_table_, 64);
+        int32_t counter = 0;
+        int32_t sum = 0;
+        while (const auto record = cursor->next())
+        {
+            sum += (*record)[0]->as<int32_t>();
+            ++counter;
+        }
+        EXPECT_EQ(counter, 250);
+        EXPECT_EQ(sum, 250 * 251 / 2);
+        EXPECT_TRUE(cursor->exhausted());
+    }
+    // Connection is released after exhausting
+    EXPECT_EQ(db_client_->count(test_table_), 250);
+
+    Conditions conditions;
+    conditions.add_field_condition(FieldCondition(std::make_unique<Field<std::string>>("description", ""), "=",
+                                                  std::make_unique<Field<std::string>>("", "Pers1")));
+    const auto view_cursor = db_client_->stream(test_table_, conditions, 50);
+    int32_t viewed = 0;
+    while (const auto record = view_cursor->next_view())
+    {
+        EXPECT_EQ(record->view(2), "Pers1");
+        ++viewed;
+    }
+    EXPECT_EQ(viewed, 125);
+
+    // Cursor inside the client transaction, closed before commit
+    db_client_->start_transaction();
+    {
+        const auto cursor = db_client_->stream(test_table_, 100);
+        ASSERT_TRUE(cursor->next().has_value());
+        EXPECT_EQ(db_client_->count(test_table_), 250);
+        cursor->close();
+        EXPECT_FALSE(cursor->next().has_value());
+    }
+    db_client_->commit_transaction();
+}
+
+TEST_F(PqxxClientTest, ViewBatchTest)
+{
+    std::vector<Record> records;
+    for (int i = 1; i <= 100; ++i)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", i));
+        record.push_back(std::make_unique<Field<std::string>>("name", "User" + std::to_string(i)));
+        record.push_back(std::make_unique<Field<std::string>>("description", i % 4 == 0 ? "yellow fruit" : "root"));
+        records.push_back(std::move(record));
+    }
+    EXPECT_NO_THROW(db_client_->insert(test_table_, std::move(records)));
+
+    std::vector<interfaces::ViewQuery> queries(3);
+    queries[0].table_name = test_table_;
+    queries[0].conditions.add_pattern_condition(PatternCondition("fruit"));
+    queries[1].table_name = test_table_;
+    queries[1].conditions.set_page_condition(PageCondition(30));
+    // All rows
+    queries[2].table_name = test_table_;
+    const auto results = db_client_->view_batch(queries);
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results[0].size(), 25);
+    EXPECT_EQ(results[1].size(), 30);
+    EXPECT_EQ(results[2].size(), 100);
+    for (const auto &row: results[0])
+    {
+        EXPECT_EQ(row->view(2), "yellow fruit");
+    }
+
+    // Same shapes again run as prepared statements
+    const auto cached_results = db_client_->view_batch(queries);
+    EXPECT_EQ(cached_results[0].size(), 25);
+    EXPECT_EQ(cached_results[1].size(), 30);
+    EXPECT_EQ(cached_results[2].size(), 100);
+
+    // Batch inside the client transaction sees its changes
+    db_client_->start_transaction();
+    db_client_->truncate_table(test_table_);
+    EXPECT_TRUE(db_client_->view_batch(queries)[2].empty());
+    db_client_->rollback_transaction();
+    EXPECT_EQ(db_client_->view_batch(queries)[2].size(), 100);
+
+    // Values are inlined as quoted literals
+    std::vector<Record> quoted(1);
+    quoted.front().push_back(std::make_unique<Field<int>>("id", 101));
+    quoted.front().push_back(std::make_unique<Field<std::string>>("name", "O'Brien \\ $1"));
+    quoted.front().push_back(std::make_unique<Field<std::string>>("description", ""));
+    db_client_->insert(test_table_, std::move(quoted));
+    std::vector<interfaces::ViewQuery> by_name(1);
+    by_name.front().table_name = test_table_;
+    by_name.front().conditions.add_field_condition(
+        FieldCondition(std::make_unique<Field<std::string>>("name", ""), "=",
+                       std::make_unique<Field<std::string>>("", "O'Brien \\ $1")));
+    const auto named = db_client_->view_batch(by_name);
+    ASSERT_EQ(named.front().size(), 1);
+    EXPECT_EQ(named.front().front()->view(1), "O'Brien \\ $1");
+}
+
 // ------------------------------ SPEED TESTS ------------------------------//
 
 TEST_F(PqxxClientTest, InsertSpeedTest)
@@ -831,12 +1560,10 @@ TEST_F(PqxxClientTest, InsertMultithreadSpeedTestWithDropppingFts)
         record1.push_back(std::make_unique<Field<std::string>>("description", "Pers" + std::to_string(i % 3)));
         records.push_back(std::move(record1));
     }
-    stopwatch.start("Multithreading insert with dropping fts");
-    stopwatch.flag("Threading launch: 6 threads");
-    // stopwatch.flag("Thread " + std::to_string + " finished");
+    stopwatch.start("Bulk insert with dropping fts");
     const std::shared_ptr<PqxxClient> db_client_n = std::dynamic_pointer_cast<PqxxClient>(db_client_);
-    utilities::bulk_insertion(db_client_n, test_table_, std::move(records), flush, 6);
-    stopwatch.flag("Threading finished: 6 threads");
+    utilities::bulk_insertion(db_client_n, test_table_, std::move(records), flush);
+    stopwatch.flag("Bulk load finished");
     // Fetch the records from the database
     const auto results = db_client_->view(test_table_);
     stopwatch.flag("Viewed");
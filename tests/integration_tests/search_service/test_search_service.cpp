@@ -0,0 +1,77 @@
+// test_search_service.cpp
+
+#include <chrono>
+#include <thread>
+#include <db_interface_factory.hpp>
+#include <db_interface_pool.hpp>
+#include <gtest/gtest.h>
+
+#include "handbook_base.hpp"
+#include "search_service_internal.hpp"
+using namespace drug_lib::common::database;
+using namespace std::chrono_literals;
+
+class SearchServiceTest : public testing::Test
+{
+protected:
+    // Database connection parameters
+    //
+    static constexpr auto port = 5432;
+    static constexpr auto host = "localhost";
+    static constexpr auto db_name = "test_db";
+    static constexpr auto username = "postgres";
+    static constexpr auto password = "postgres"; // Replace it with your actual password
+
+    std::shared_ptr<creational::DbInterfacePool> pool_;
+    drug_lib::services::SearchServiceInternal service_;
+
+    void SetUp() override
+    {
+        pool_ = std::make_shared<creational::DbInterfacePool>(creational::PoolSettings{});
+        pool_->fill(2, creational::DbInterfaceFactory::create_pqxx_client,
+                    PqxxConnectParams{host, port, db_name, username, password});
+        service_.pool_setup(pool_);
+    }
+
+    // Wait until every lease is returned to the pool
+    [[nodiscard]] bool wait_all_returned(const std::chrono::milliseconds timeout) const
+    {
+        const auto until = std::chrono::steady_clock::now() + timeout;
+        while (pool_->metrics().in_use != 0 && std::chrono::steady_clock::now() < until)
+        {
+            std::this_thread::sleep_for(10ms);
+        }
+        return pool_->metrics().in_use == 0;
+    }
+};
+
+// A handbook locked by another transaction misses the deadline: its query is cancelled,
+// the connection and the worker are free before the lock is gone
+TEST_F(SearchServiceTest, LateSubSearchIsCancelledTest)
+{
+    service_.set_search_deadline(200ms);
+
+    const std::shared_ptr<interfaces::DbInterface> blocker =
+        creational::DbInterfaceFactory::create_pqxx_client({host, port, db_name, username, password});
+    blocker->start_transaction();
+    blocker->truncate_table(drug_lib::dao::table_names::medicaments);
+
+    const auto started = std::chrono::steady_clock::now();
+    EXPECT_NO_THROW(static_cast<void>(service_.search_through_all("aspirin")));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 1s);
+    EXPECT_TRUE(wait_all_returned(1s));
+
+    blocker->rollback_transaction();
+
+    // Statement timeout of the cancelled search doesn't stay on its connection
+    service_.set_search_deadline(5s);
+    EXPECT_NO_THROW(static_cast<void>(service_.search_through_all("aspirin")));
+    EXPECT_TRUE(wait_all_returned(1s));
+    EXPECT_EQ(pool_->metrics().total, 2);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
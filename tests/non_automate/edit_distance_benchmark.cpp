@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "edit_distance.hpp"
+
+// Scores one pattern against candidate names: the full table as it was computed before, bit-parallel distance,
+// bounded distance and the batch. Run on a release build
+
+using namespace drug_lib::services;
+
+namespace
+{
+    constexpr std::size_t candidates_count = 100000;
+    constexpr uint32_t max_distance = 3;
+
+    uint32_t full_table_distance(const std::u32string& pattern, const std::u32string& text)
+    {
+        std::vector table(pattern.size() + 1, std::vector<uint32_t>(text.size() + 1));
+        for (std::size_t i = 0; i <= pattern.size(); ++i)
+        {
+            for (std::size_t j = 0; j <= text.size(); ++j)
+            {
+                if (i == 0 || j == 0)
+                {
+                    table[i][j] = static_cast<uint32_t>(i + j);
+                }
+                else
+                {
+                    table[i][j] = std::min({
+                        table[i - 1][j] + 1, table[i][j - 1] + 1,
+                        table[i - 1][j - 1] + (pattern[i - 1] == text[j - 1] ? 0u : 1u)
+                    });
+                }
+            }
+        }
+        return table[pattern.size()][text.size()];
+    }
+
+    std::vector<std::u32string> make_candidates()
+    {
+        std::mt19937 generator(7);
+        std::vector<std::u32string> candidates;
+        candidates.reserve(candidates_count);
+        for (std::size_t i = 0; i < candidates_count; ++i)
+        {
+            std::u32string name;
+            const std::size_t length = 6 + generator() % 20;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                name.push_back(generator() % 4 == 0 ? U'а' + generator() % 32 : U'a' + generator() % 26);
+            }
+            candidates.push_back(std::move(name));
+        }
+        return candidates;
+    }
+
+    template <typename Func>
+    void measure(const std::string& title, Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t checksum = func();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << title << ": " << elapsed.count() / candidates_count << " ns per candidate, checksum "
+            << checksum << std::endl;
+    }
+}
+
+int main()
+{
+    const std::vector<std::u32string> candidates = make_candidates();
+    const std::u32string pattern = U"paracetamolum";
+    const EditDistance distance(pattern);
+    std::cout << candidates_count << " candidates, pattern of " << pattern.size() << " symbols" << std::endl;
+
+    measure("Full table", [&]
+    {
+        uint64_t sum = 0;
+        for (const auto& candidate : candidates)
+        {
+            sum += std::min(full_table_distance(pattern, candidate), max_distance + 1);
+        }
+        return sum;
+    });
+    measure("Bit-parallel", [&]
+    {
+        uint64_t sum = 0;
+        for (const auto& candidate : candidates)
+        {
+            sum += std::min(distance(candidate), max_distance + 1);
+        }
+        return sum;
+    });
+    measure("Bit-parallel bounded", [&]
+    {
+        uint64_t sum = 0;
+        for (const auto& candidate : candidates)
+        {
+            sum += distance.bounded(candidate, max_distance);
+        }
+        return sum;
+    });
+    measure("Batch", [&]
+    {
+        std::vector<uint32_t> distances(candidates.size());
+        distance.bounded(candidates, max_distance, distances);
+        uint64_t sum = 0;
+        for (const uint32_t value : distances)
+        {
+            sum += value;
+        }
+        return sum;
+    });
+    return 0;
+}
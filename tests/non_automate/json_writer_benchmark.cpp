@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include "objects.hpp"
+
+// Compares building a search response through Json::Value and serializing it, as newHttpJsonResponse does,
+// with writing it by JsonWriter. Run on a release build
+
+using namespace drug_lib;
+using namespace drug_lib::data;
+
+namespace
+{
+    constexpr std::size_t objects_count = 1000;
+    constexpr std::size_t rounds = 50;
+
+    std::vector<objects::Medicament> make_medicaments(const bool raw_properties)
+    {
+        std::vector<objects::Medicament> medicaments;
+        medicaments.reserve(objects_count);
+        for (std::size_t i = 0; i < objects_count; ++i)
+        {
+            objects::Medicament medicament(common::database::Uuid(std::to_string(i), true),
+                                           "Medicament " + std::to_string(i), "Painkiller", i % 2 == 0,
+                                           "ABUIT" + std::to_string(i), "accepted", "N02BA01");
+            medicament.add_property(PropertyFactory::create<objects::medicaments::SideEffects>(
+                std::vector<std::string>{"Nausea", "Headache", "Dizziness"}));
+            medicament.add_property(PropertyFactory::create<objects::medicaments::ActiveIngredients>(
+                std::vector{
+                    objects::medicaments::ActiveIngredient("Acetylsalicylic acid", 2),
+                    objects::medicaments::ActiveIngredient("Caffeine", 1)
+                }));
+            if (raw_properties)
+            {
+                // As read from the database by view
+                objects::Medicament viewed = medicament;
+                auto record = std::make_unique<common::database::BaseViewRecord>();
+                for (const auto& field : medicament.to_record())
+                {
+                    record->add_field(
+                        common::database::ViewingField(std::string(field->get_name()), field->to_string()));
+                }
+                std::unique_ptr<common::database::ViewRecord> row = std::move(record);
+                viewed.from_record(row);
+                medicaments.push_back(std::move(viewed));
+            }
+            else
+            {
+                medicaments.push_back(std::move(medicament));
+            }
+        }
+        return medicaments;
+    }
+
+    template <typename Func>
+    double measure_ms(Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t bytes = 0;
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            bytes += func().size();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        // Keeps the results alive for the optimizer
+        if (bytes == 0)
+        {
+            std::cout << "Empty output" << std::endl;
+        }
+        return elapsed.count() / rounds;
+    }
+
+    void run(const std::string& title, const std::vector<objects::Medicament>& medicaments)
+    {
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "";
+        const double tree_ms = measure_ms([&]
+        {
+            Json::Value response(Json::arrayValue);
+            for (const auto& medicament : medicaments)
+            {
+                Json::Value object = medicament.to_json();
+                object["match"] = "PARTIAL_MATCH";
+                response.append(std::move(object));
+            }
+            return Json::writeString(builder, response);
+        });
+        const double writer_ms = measure_ms([&]
+        {
+            std::string body;
+            JsonWriter writer(body);
+            writer.begin_array();
+            for (const auto& medicament : medicaments)
+            {
+                writer.begin_object();
+                medicament.write_members(writer);
+                writer.member("match", "PARTIAL_MATCH");
+                writer.end_object();
+            }
+            writer.end_array();
+            return body;
+        });
+        std::cout << title << ": Json::Value " << tree_ms << " ms, JsonWriter " << writer_ms << " ms, speedup "
+            << tree_ms / writer_ms << "x" << std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << objects_count << " medicaments per response, average of " << rounds << " rounds" << std::endl;
+    run("Decoded properties", make_medicaments(false));
+    run("Raw properties", make_medicaments(true));
+    return 0;
+}
@@ -26,7 +26,7 @@ void print_results(const drug_lib::services::SearchResponse &results)
         std::cout << "No results found.\n";
         return;
     }
-    for (const auto &[obj, match]: results)
+    for (const auto &[obj, match, relevance]: results)
     {
         std::cout << obj->to_json().toStyledString() << "\n"; // Assuming ObjectBase has a `to_string` method
     }
@@ -90,7 +90,7 @@ int main()
                 std::cout << "Enter search pattern: ";
                 std::getline(std::cin, pattern); {
                     // Replace ` YourType` with the appropriate type you want to test
-                    auto results = search_service.direct_search_diseases(pattern);
+                    auto results = search_service.direct_search<drug_lib::data::objects::Disease>(pattern);
                     print_results(results);
                 }
                 break;
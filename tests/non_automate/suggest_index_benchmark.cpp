@@ -0,0 +1,56 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "suggest_index.hpp"
+
+// Time of one suggestion over a large corpus, for patterns typed symbol by symbol. Run on a release build
+
+using namespace drug_lib::services;
+
+namespace
+{
+    constexpr std::size_t names_count = 200000;
+    constexpr std::size_t limit = 10;
+    constexpr std::size_t repeats = 1000;
+
+    SuggestIndex make_index()
+    {
+        std::mt19937 generator(7);
+        SuggestIndex index;
+        for (std::size_t i = 0; i < names_count; ++i)
+        {
+            std::string name;
+            const std::size_t length = 6 + generator() % 20;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                name.push_back(static_cast<char>('a' + generator() % 26));
+            }
+            index.add(name);
+        }
+        return index;
+    }
+}
+
+int main()
+{
+    const SuggestIndex index = make_index();
+    std::cout << index.size() << " names" << std::endl;
+    for (const auto& [pattern, max_distance] : std::vector<std::pair<std::string, uint32_t>>{
+             {"p", 0}, {"pa", 0}, {"par", 0}, {"para", 0}, {"parac", 1}, {"paracet", 1}, {"paracetam", 2}
+         })
+    {
+        std::size_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < repeats; ++i)
+        {
+            found += index.suggest(pattern, limit, max_distance).size();
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << pattern << " (distance " << max_distance << "): " << elapsed.count() / repeats
+            << " us per suggestion, " << found / repeats << " names" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <coroutine>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "async_db_executor.hpp"
+
+using namespace drug_lib::common::database;
+
+namespace
+{
+    // Minimal eager coroutine completing a promise with its result
+    struct FireAndForget
+    {
+        struct promise_type
+        {
+            FireAndForget get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    FireAndForget await_value(behavioral::AsyncDbExecutor& executor, std::promise<int>& result,
+                              behavioral::AsyncDbExecutor::Resumer resumer = {})
+    {
+        try
+        {
+            result.set_value(co_await executor.run([] { return 42; }, std::move(resumer)));
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+
+    FireAndForget await_failure(behavioral::AsyncDbExecutor& executor, std::promise<void>& result)
+    {
+        try
+        {
+            co_await executor.run([] { throw std::runtime_error("Database is down"); });
+            result.set_value();
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+}
+
+TEST(AsyncDbExecutorTest, TestZeroWorkers)
+{
+    EXPECT_THROW(behavioral::AsyncDbExecutor executor(0), std::invalid_argument);
+}
+
+TEST(AsyncDbExecutorTest, TestSubmitReturnsResult)
+{
+    behavioral::AsyncDbExecutor executor(2);
+    auto future = executor.submit([] { return std::this_thread::get_id(); });
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+TEST(AsyncDbExecutorTest, TestSubmitPropagatesException)
+{
+    behavioral::AsyncDbExecutor executor(1);
+    auto future = executor.submit([]() -> int { throw std::runtime_error("Database is down"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(AsyncDbExecutorTest, TestCoroutineAwaitsResult)
+{
+    behavioral::AsyncDbExecutor executor(1);
+    std::promise<int> result;
+    await_value(executor, result);
+    EXPECT_EQ(result.get_future().get(), 42);
+}
+
+TEST(AsyncDbExecutorTest, TestCoroutineRethrowsException)
+{
+    behavioral::AsyncDbExecutor executor(1);
+    std::promise<void> result;
+    await_failure(executor, result);
+    EXPECT_THROW(result.get_future().get(), std::runtime_error);
+}
+
+TEST(AsyncDbExecutorTest, TestCoroutineResumedByResumer)
+{
+    behavioral::AsyncDbExecutor executor(1);
+    std::promise<int> result;
+    std::atomic<int> resumed{0};
+    await_value(executor, result, [&resumed](const std::function<void()>& resume)
+    {
+        ++resumed;
+        resume();
+    });
+    EXPECT_EQ(result.get_future().get(), 42);
+    EXPECT_EQ(resumed, 1);
+}
+
+TEST(AsyncDbExecutorTest, TestQueuedWorkFinishedOnDestruction)
+{
+    std::atomic<int> done{0};
+    {
+        behavioral::AsyncDbExecutor executor(2);
+        for (int i = 0; i < 100; ++i)
+        {
+            (void)executor.submit([&done]
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                ++done;
+            });
+        }
+    }
+    EXPECT_EQ(done, 100);
+}
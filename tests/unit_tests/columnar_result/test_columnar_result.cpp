@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "db_columnar.hpp"
+#include "mock_db_client.hpp"
+
+using namespace drug_lib::common::database;
+
+namespace
+{
+    Record make_record(const int id, const std::string& name, const bool active)
+    {
+        Record record;
+        record.push_back(std::make_unique<Field<int>>("id", id));
+        record.push_back(std::make_unique<Field<std::string>>("name", name));
+        record.push_back(std::make_unique<Field<bool>>("active", active));
+        record.push_back(std::make_unique<Field<Uuid>>("owner", id % 2 ? Uuid().set_null() : Uuid("owner", false)));
+        return record;
+    }
+}
+
+TEST(ColumnarResultTest, TestUnsupportedType)
+{
+    EXPECT_THROW(Column("id", SqlType::UNSUPPORTED), std::invalid_argument);
+}
+
+TEST(ColumnarResultTest, TestTypedColumns)
+{
+    ColumnarResult result;
+    Column& ids = result.add_column("id", SqlType::BIGINT);
+    for (int i = 0; i < 100; ++i)
+    {
+        ids.append_integer(i);
+    }
+    Column& scores = result.add_column("score", SqlType::DOUBLE_PRECISION);
+    for (int i = 0; i < 100; ++i)
+    {
+        scores.append_real(i / 2.);
+    }
+    Column& names = result.add_column("name", SqlType::TEXT);
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            names.append_null();
+        }
+        else
+        {
+            names.append_text("name_" + std::to_string(i));
+        }
+    }
+    const auto now = std::chrono::system_clock::now();
+    Column& created = result.add_column("created", SqlType::TIMESTAMP);
+    for (int i = 0; i < 100; ++i)
+    {
+        created.append_timestamp(now);
+    }
+
+    ASSERT_EQ(result.rows(), 100);
+    EXPECT_EQ(result.columns_count(), 4);
+    const auto values = result.column("id").integers();
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), int64_t{0}), 4950);
+    EXPECT_DOUBLE_EQ(result.column(1).reals()[9], 4.5);
+    EXPECT_EQ(result.column("name").null_count(), 10);
+    EXPECT_TRUE(result.column("name").is_null(70));
+    EXPECT_EQ(result.column("name").text(70), "");
+    EXPECT_EQ(result.column("name").text(71), "name_71");
+    EXPECT_EQ(result.column("created").timestamp(99), now);
+    EXPECT_THROW((void)result.column("score").integers(), std::logic_error);
+    EXPECT_THROW((void)result.column("missing"), std::out_of_range);
+}
+
+TEST(ColumnarResultTest, TestAppendRecord)
+{
+    ColumnarResult result;
+    for (int i = 0; i < 4; ++i)
+    {
+        result.append_record(make_record(i, "name_" + std::to_string(i), i % 2 == 0));
+    }
+    ASSERT_EQ(result.rows(), 4);
+    EXPECT_EQ(result.column("id").type(), SqlType::INT);
+    EXPECT_EQ(result.column("name").text(3), "name_3");
+    EXPECT_EQ(result.column("active").booleans()[2], 1);
+    EXPECT_TRUE(result.column("owner").is_null(1));
+    EXPECT_EQ(result.column("owner").text(2), "owner");
+
+    Record other;
+    other.push_back(std::make_unique<Field<int>>("id", 5));
+    EXPECT_THROW(result.append_record(other), std::invalid_argument);
+}
+
+TEST(ColumnarResultTest, TestMockSelectColumns)
+{
+    MockDbClient client;
+    std::vector<Record> rows;
+    for (int i = 0; i < 10; ++i)
+    {
+        rows.push_back(make_record(i, "name", true));
+    }
+    client.bulk_load("table", std::move(rows));
+
+    const auto result = client.select_columns("table");
+    ASSERT_EQ(result.rows(), 10);
+    EXPECT_EQ(result.column("id").integers()[7], 7);
+    EXPECT_TRUE(client.select_columns("missing").empty());
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <thread>
 #include <memory>
 #include <boost/function/function_template.hpp>
@@ -56,7 +57,7 @@ TEST_F(DbInterfacePoolTest, TestPoolExhaustion)
     }
 
     // The pool should now be empty
-    EXPECT_THROW(pool.acquire_db_interface(), std::runtime_error);
+    EXPECT_THROW(pool.acquire_db_interface(std::chrono::milliseconds(10)), exceptions::ConnectionException);
 }
 
 // Test filling the pool with a custom size
@@ -72,7 +73,7 @@ TEST_F(DbInterfacePoolTest, TestCustomFillSize)
     }
 
     // Expect exhaustion after acquiring all 3
-    EXPECT_THROW(customPool.acquire_db_interface(), std::runtime_error);
+    EXPECT_THROW(customPool.acquire_db_interface(std::chrono::milliseconds(10)), std::runtime_error);
 }
 
 // Test that the factory function fails gracefully
@@ -132,3 +133,161 @@ TEST_F(DbInterfacePoolTest, TestReleaseNull)
     EXPECT_THROW(pool.release_db_interface(std::move(nullInterface)), std::invalid_argument);
     // Should throw or affect the pool
 }
+
+// Test that the lease returns the connection on scope exit
+TEST_F(DbInterfacePoolTest, TestLeaseReturnsOnScopeExit)
+{
+    {
+        const auto lease = pool.lease();
+        EXPECT_TRUE(lease);
+        EXPECT_EQ(pool.metrics().in_use, 1);
+        EXPECT_EQ(pool.metrics().idle, 4);
+    }
+    EXPECT_EQ(pool.metrics().in_use, 0);
+    EXPECT_EQ(pool.metrics().idle, 5);
+
+    auto lease = pool.lease();
+    auto moved = std::move(lease);
+    EXPECT_FALSE(lease);
+    moved.reset();
+    EXPECT_EQ(pool.metrics().idle, 5);
+}
+
+// Test that acquire waits for a connection released by another thread
+TEST_F(DbInterfacePoolTest, TestAcquireWaitsForRelease)
+{
+    std::vector<creational::DbInterfacePool::Lease> leases;
+    for (int i = 0; i < 5; ++i)
+    {
+        leases.push_back(pool.lease());
+    }
+    std::jthread releaser([&leases]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        leases.back().reset();
+    });
+    const auto lease = pool.lease(std::chrono::milliseconds(2000));
+    EXPECT_TRUE(lease);
+    const auto metrics = pool.metrics();
+    EXPECT_EQ(metrics.acquisitions, 6);
+    EXPECT_GE(metrics.max_wait, std::chrono::milliseconds(10));
+}
+
+// Test growing up to max size and the timeout after it
+TEST_F(DbInterfacePoolTest, TestGrowToMaxSize)
+{
+    creational::PoolSettings settings;
+    settings.max_size = 3;
+    settings.acquire_timeout = std::chrono::milliseconds(10);
+    creational::DbInterfacePool growing_pool(settings);
+    growing_pool.fill(1, create_mock_database);
+
+    std::vector<creational::DbInterfacePool::Lease> leases;
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_NO_THROW(leases.push_back(growing_pool.lease()));
+    }
+    EXPECT_EQ(growing_pool.metrics().total, 3);
+    EXPECT_DOUBLE_EQ(growing_pool.metrics().utilisation(), 1.0);
+    EXPECT_THROW(auto lease = growing_pool.lease(), exceptions::ConnectionException);
+    EXPECT_EQ(growing_pool.metrics().timeouts, 1);
+}
+
+// Test that health check replaces dropped connections and tops up to min size
+TEST_F(DbInterfacePoolTest, TestInitializerPreparesEveryConnection)
+{
+    creational::PoolSettings settings;
+    settings.max_size = 3;
+    creational::DbInterfacePool prepared_pool(settings);
+    prepared_pool.fill(2, create_mock_database);
+
+    std::atomic<int> prepared{0};
+    prepared_pool.set_initializer([&prepared](const std::shared_ptr<interfaces::DbInterface>&)
+    {
+        ++prepared;
+    });
+    EXPECT_EQ(prepared, 2);
+
+    // Grown connection is prepared as well
+    std::vector<creational::DbInterfacePool::Lease> leases;
+    for (int i = 0; i < 3; ++i)
+    {
+        leases.push_back(prepared_pool.lease());
+    }
+    EXPECT_EQ(prepared, 3);
+}
+
+TEST_F(DbInterfacePoolTest, TestHealthCheckReplacesDeadConnections)
+{
+    creational::PoolSettings settings;
+    settings.min_size = 4;
+    settings.max_size = 4;
+    creational::DbInterfacePool checked_pool(settings);
+    checked_pool.fill(2, create_mock_database);
+    {
+        const auto lease = checked_pool.lease();
+        lease->drop_connect();
+    }
+    checked_pool.check_health();
+    const auto metrics = checked_pool.metrics();
+    EXPECT_EQ(metrics.replaced, 1);
+    EXPECT_EQ(metrics.total, 4);
+    EXPECT_EQ(metrics.idle, 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto connect = checked_pool.acquire_db_interface();
+        EXPECT_TRUE(connect->is_alive());
+    }
+}
+
+// Test that acquire isn't blocked by a health check of slow connections
+TEST_F(DbInterfacePoolTest, TestAcquireDuringSlowHealthCheck)
+{
+    creational::PoolSettings settings;
+    settings.acquire_timeout = std::chrono::milliseconds(50);
+    creational::DbInterfacePool checked_pool(settings);
+    checked_pool.fill(3, []
+    {
+        auto connect = std::make_shared<MockDbClient>();
+        connect->set_alive_delay(std::chrono::milliseconds(100));
+        return std::static_pointer_cast<interfaces::DbInterface>(connect);
+    });
+
+    std::atomic<bool> checked{false};
+    std::jthread checker([&checked_pool, &checked]
+    {
+        checked_pool.check_health();
+        checked = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    int acquired = 0;
+    while (!checked)
+    {
+        EXPECT_NO_THROW(static_cast<void>(checked_pool.lease()));
+        ++acquired;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    checker.join();
+    EXPECT_GT(acquired, 10);
+    EXPECT_EQ(checked_pool.metrics().timeouts, 0);
+    EXPECT_EQ(checked_pool.metrics().idle, 3);
+}
+
+// Test background health checks
+TEST_F(DbInterfacePoolTest, TestBackgroundHealthCheck)
+{
+    creational::PoolSettings settings;
+    settings.health_check_interval = std::chrono::milliseconds(5);
+    creational::DbInterfacePool checked_pool(settings);
+    checked_pool.fill(1, create_mock_database);
+    {
+        const auto lease = checked_pool.lease();
+        lease->drop_connect();
+    }
+    for (int i = 0; i < 200 && checked_pool.metrics().replaced == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(checked_pool.metrics().replaced, 1);
+    EXPECT_TRUE(checked_pool.lease()->is_alive());
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "edit_distance.hpp"
+
+using namespace drug_lib::services;
+
+namespace
+{
+    uint32_t full_table_distance(const std::u32string& pattern, const std::u32string& text)
+    {
+        std::vector table(pattern.size() + 1, std::vector<uint32_t>(text.size() + 1));
+        for (std::size_t i = 0; i <= pattern.size(); ++i)
+        {
+            for (std::size_t j = 0; j <= text.size(); ++j)
+            {
+                if (i == 0 || j == 0)
+                {
+                    table[i][j] = static_cast<uint32_t>(i + j);
+                }
+                else
+                {
+                    table[i][j] = std::min({
+                        table[i - 1][j] + 1, table[i][j - 1] + 1,
+                        table[i - 1][j - 1] + (pattern[i - 1] == text[j - 1] ? 0u : 1u)
+                    });
+                }
+            }
+        }
+        return table[pattern.size()][text.size()];
+    }
+
+    std::u32string random_text(std::mt19937& generator, const std::size_t length)
+    {
+        // Small alphabet of latin and cyrillic symbols, so texts have many matches
+        static constexpr char32_t alphabet[] = U"abcdяюэ";
+        std::u32string text;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            text.push_back(alphabet[generator() % (std::size(alphabet) - 1)]);
+        }
+        return text;
+    }
+}
+
+TEST(EditDistanceTest, TestKnownDistances)
+{
+    EXPECT_EQ(EditDistance(U"kitten")(U"sitting"), 3);
+    EXPECT_EQ(EditDistance(U"aspirin")(U"aspirin"), 0);
+    EXPECT_EQ(EditDistance(U"")(U"abc"), 3);
+    EXPECT_EQ(EditDistance(U"abc")(U""), 3);
+    EXPECT_EQ(EditDistance(U"анальгин")(U"анольгин"), 1);
+}
+
+TEST(EditDistanceTest, TestBound)
+{
+    const EditDistance distance(U"paracetamol");
+    EXPECT_EQ(distance.bounded(U"paracetamol", 0), 0);
+    EXPECT_EQ(distance.bounded(U"paractamol", 1), 1);
+    EXPECT_EQ(distance.bounded(U"ibuprofen", 2), 3);
+    EXPECT_EQ(distance.bounded(U"para", 2), 3);
+}
+
+TEST(EditDistanceTest, TestMatchesFullTable)
+{
+    std::mt19937 generator(42);
+    for (int round = 0; round < 500; ++round)
+    {
+        // Patterns longer than a word go through the row by row fallback
+        const EditDistance distance(random_text(generator, generator() % 80));
+        std::vector<std::u32string> texts;
+        for (int i = 0; i < 7; ++i)
+        {
+            texts.push_back(random_text(generator, generator() % 80));
+        }
+        const uint32_t bound = generator() % 16;
+        std::vector<uint32_t> batch(texts.size());
+        distance.bounded(texts, bound, batch);
+        for (std::size_t i = 0; i < texts.size(); ++i)
+        {
+            const uint32_t expected = full_table_distance(distance.pattern(), texts[i]);
+            ASSERT_EQ(distance(texts[i]), expected);
+            ASSERT_EQ(distance.bounded(texts[i], bound), std::min(expected, bound + 1));
+            ASSERT_EQ(batch[i], std::min(expected, bound + 1));
+        }
+    }
+}
@@ -91,6 +91,51 @@ TEST(PatientTest, FromRecord)
 }
 
 
+TEST(PatientTest, FromViewRecord)
+{
+    auto record = std::make_unique<common::database::BaseViewRecord>();
+    record->add_field(common::database::ViewingField(shared::field_name::id, "4"));
+    record->add_field(common::database::ViewingField(patient::field_name::gender, "Male"));
+    record->add_field(common::database::ViewingField(patient::field_name::birth_date, "1990-05-17 00:00:00"));
+    record->add_field(common::database::ViewingField(patient::field_name::name, "Bob Brown"));
+    std::unique_ptr<common::database::ViewRecord> viewed = std::move(record);
+
+    Patient patient;
+    patient.from_record(viewed);
+
+    EXPECT_EQ(patient.get_id(), "4");
+    EXPECT_EQ(patient.get_name(), "Bob Brown");
+    EXPECT_EQ(patient.get_gender(), "Male");
+    EXPECT_EQ(patient.get_birth_date(), std::chrono::year_month_day(std::chrono::year(1990), std::chrono::month(5),
+                                                                     std::chrono::day(17)));
+}
+
+TEST(PatientTest, FromViewRecordBinding)
+{
+    std::vector<std::unique_ptr<common::database::BaseViewRecord>> rows;
+    for (const auto& [id, name] : {std::pair{"5", "Carol"}, std::pair{"6", "Dave"}})
+    {
+        auto record = std::make_unique<common::database::BaseViewRecord>();
+        record->add_field(common::database::ViewingField(patient::field_name::name, name));
+        record->add_field(common::database::ViewingField(shared::field_name::id, id));
+        record->add_field(common::database::ViewingField(patient::field_name::gender, "Female"));
+        rows.push_back(std::move(record));
+    }
+
+    const RowBinding binding = Patient::bind(*rows.front()->columns());
+    std::vector<Patient> patients(rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+        patients[i].from_record(*rows[i], binding);
+    }
+    EXPECT_EQ(patients[0].get_id(), "5");
+    EXPECT_EQ(patients[1].get_name(), "Dave");
+    EXPECT_EQ(patients[1].get_gender(), "Female");
+
+    rows.front()->add_field(common::database::ViewingField("unknown", "value"));
+    EXPECT_THROW((void)Patient::bind(*rows.front()->columns()), std::invalid_argument);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <limits>
+
+#include "objects.hpp"
+
+namespace drug_lib::data
+{
+    namespace
+    {
+        Json::Value parse(const std::string& text)
+        {
+            Json::Value result = detail::parse_json(text);
+            EXPECT_FALSE(result.isNull()) << text;
+            return result;
+        }
+
+        template <typename Object>
+        void expect_same_json(const Object& object)
+        {
+            // Compared as text, parsed numbers don't keep the signedness of the original values
+            EXPECT_EQ(parse(object.to_json_text()).toStyledString(), object.to_json().toStyledString());
+        }
+    }
+
+    TEST(JsonWriterTest, Nesting)
+    {
+        std::string out;
+        JsonWriter writer(out);
+        writer.begin_object()
+              .member("a", 1)
+              .key("b").begin_array().value(true).null().value(-2.5).begin_object().end_object().end_array()
+              .member("c", std::string("text"))
+              .key("d").raw(R"({"x":[1]})")
+              .end_object();
+        EXPECT_EQ(out, R"({"a":1,"b":[true,null,-2.5,{}],"c":"text","d":{"x":[1]}})");
+    }
+
+    TEST(JsonWriterTest, Escaping)
+    {
+        std::string out;
+        JsonWriter writer(out);
+        writer.begin_array()
+              .value("quote \" slash \\ tab \t line \n bell \x07")
+              .value("юникод")
+              .value(std::numeric_limits<double>::infinity())
+              .end_array();
+        EXPECT_EQ(out, "[\"quote \\\" slash \\\\ tab \\t line \\n bell \\u0007\",\"юникод\",null]");
+        const Json::Value parsed = parse(out);
+        EXPECT_EQ(parsed[0].asString(), "quote \" slash \\ tab \t line \n bell \x07");
+        EXPECT_EQ(parsed[1].asString(), "юникод");
+    }
+
+    TEST(JsonWriterTest, TreeFallback)
+    {
+        Json::Value tree;
+        tree["name"] = "value";
+        tree["numbers"].append(1);
+        tree["numbers"].append(Json::UInt64(1) << 40);
+        tree["numbers"].append(0.1);
+        tree["nested"]["flag"] = false;
+        std::string out;
+        JsonWriter(out).value(tree);
+        EXPECT_EQ(parse(out).toStyledString(), tree.toStyledString());
+    }
+
+    TEST(JsonWriterTest, ObjectsMatchToJson)
+    {
+        objects::Medicament medicament(common::database::Uuid("1", true), "Aspirin", "Painkiller", true,
+                                       "ABUIT123", "accepted", "AV12");
+        medicament.add_property(PropertyFactory::create<objects::medicaments::SideEffects>(
+            std::vector<std::string>{"Nausea", "Head\"ache"}));
+        expect_same_json(medicament);
+
+        objects::Disease disease(common::database::Uuid("2", true), "Flu", "Viral", true);
+        disease.add_property(PropertyFactory::create<objects::diseases::Symptoms>(
+            std::vector{objects::diseases::Symptom("Fever", "High", "3 days", "Physical", "Temperature")}));
+        expect_same_json(disease);
+
+        objects::Organization organization(common::database::Uuid("3", true), "Org", "Pharmacy", "US", "contacts");
+        organization.add_property(PropertyFactory::create<objects::organizations::License>("License", "KEY"));
+        expect_same_json(organization);
+
+        const objects::Patient patient(common::database::Uuid("4", true), "Bob", "Male",
+                                       std::chrono::year_month_day(std::chrono::year(1990), std::chrono::month(5),
+                                                                   std::chrono::day(17)), "contacts");
+        expect_same_json(patient);
+    }
+}
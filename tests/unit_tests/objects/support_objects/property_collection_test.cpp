@@ -72,4 +72,65 @@ namespace drug_lib::data
         EXPECT_EQ(info["license"][objects::organizations::License::names_of_json_fields::license_key].asString(),
                   "KEY1");
     }
+
+    TEST(PropertyCollectionTest, RawPassThrough)
+    {
+        const std::string raw =
+            R"({"license" : {"license_name": "Raw \"One\"", "license_key": "KEY1"}, "symptoms": [], "unknown": 1.5e3})";
+        PropertyCollection collection;
+        collection.set_raw(raw);
+        // Nothing is decoded, so unknown property isn't an error and the text is kept byte for byte
+        EXPECT_EQ(collection.to_json_text(), raw);
+        EXPECT_EQ(collection.get_collection_info()["unknown"].asDouble(), 1500.);
+
+        const auto license = std::dynamic_pointer_cast<objects::organizations::License>(
+            collection.get_property(objects::organizations::properties::license));
+        ASSERT_NE(license, nullptr);
+        EXPECT_EQ(license->get_license_name(), "Raw \"One\"");
+        license->set_license_key("KEY2");
+        EXPECT_THROW(auto v = collection.get_property("unknown"), std::invalid_argument);
+
+        // Decoded property is serialized, the others are copied
+        const Json::Value info = detail::parse_json(collection.to_json_text());
+        EXPECT_EQ(info["license"][objects::organizations::License::names_of_json_fields::license_key].asString(),
+                  "KEY2");
+        EXPECT_TRUE(info["symptoms"].isArray());
+        EXPECT_EQ(info["unknown"].asDouble(), 1500.);
+    }
+
+    TEST(PropertyCollectionTest, RawEqualsDecoded)
+    {
+        objects::organizations::License license;
+        license.set_license_name("License");
+        license.set_license_key("KEY");
+        PropertyCollection decoded;
+        decoded.add_property(PropertyFactory::create<objects::organizations::License>(license));
+
+        PropertyCollection raw;
+        raw.set_raw(decoded.to_json_text());
+        EXPECT_EQ(raw, decoded);
+
+        PropertyCollection empty;
+        empty.set_raw("null");
+        EXPECT_EQ(empty.get_collection_info().size(), 0);
+        PropertyCollection malformed;
+        malformed.set_raw("[1, 2]");
+        EXPECT_THROW(auto v = malformed.get_property("license"), std::invalid_argument);
+    }
+
+    TEST(PropertyCollectionTest, FactoryByName)
+    {
+        Json::Value value;
+        value[objects::organizations::License::names_of_json_fields::license_key] = "KEY";
+        const auto license = std::dynamic_pointer_cast<objects::organizations::License>(
+            PropertyFactory::create(objects::organizations::properties::license, value));
+        ASSERT_NE(license, nullptr);
+        EXPECT_EQ(license->get_license_key(), "KEY");
+        for (const std::string name : {objects::diseases::properties::symptoms, objects::patients::properties::vaccines})
+        {
+            EXPECT_EQ(PropertyFactory::create(name, Json::Value(Json::arrayValue))->get_name(), name);
+        }
+        EXPECT_THROW(auto v = PropertyFactory::create("licens", Json::Value()), std::invalid_argument);
+        EXPECT_THROW(auto v = PropertyFactory::create("", Json::Value()), std::invalid_argument);
+    }
 }
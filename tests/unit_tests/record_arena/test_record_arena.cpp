@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "db_field.hpp"
+#include "db_record.hpp"
+#include "db_record_arena.hpp"
+#include "mock_db_client.hpp"
+
+using namespace drug_lib::common::database;
+
+namespace
+{
+    Record make_record(const int id)
+    {
+        Record record;
+        record.reserve(3);
+        record.push_back(std::make_unique<Field<int>>("id", id));
+        record.push_back(std::make_unique<Field<std::string>>("name", "name_" + std::to_string(id)));
+        record.push_back(std::make_unique<Field<Uuid>>("owner", Uuid("owner", false)));
+        return record;
+    }
+}
+
+TEST(RecordArenaTest, TestFieldsCarvedInScope)
+{
+    RecordArena arena;
+    {
+        RecordArena::Scope scope(arena);
+        EXPECT_EQ(RecordArena::current(), &arena);
+        const Record record = make_record(1);
+        EXPECT_EQ(record[1]->as<std::string>(), "name_1");
+    }
+    EXPECT_EQ(RecordArena::current(), nullptr);
+    EXPECT_GT(arena.allocated(), 0);
+
+    // Outside of the scope fields go to the heap
+    const std::size_t allocated = arena.allocated();
+    const Record record = make_record(2);
+    EXPECT_EQ(arena.allocated(), allocated);
+    EXPECT_EQ(record[0]->as<int>(), 2);
+}
+
+TEST(RecordArenaTest, TestNestedScopes)
+{
+    RecordArena outer;
+    RecordArena inner;
+    RecordArena::Scope outer_scope(outer);
+    {
+        RecordArena::Scope inner_scope(inner);
+        EXPECT_EQ(RecordArena::current(), &inner);
+        const Record record = make_record(1);
+    }
+    EXPECT_EQ(RecordArena::current(), &outer);
+    EXPECT_EQ(outer.allocated(), 0);
+    EXPECT_GT(inner.allocated(), 0);
+}
+
+TEST(RecordArenaTest, TestResetBetweenBatches)
+{
+    RecordArena arena(1 << 10);
+    for (int batch = 0; batch < 10; ++batch)
+    {
+        {
+            RecordArena::Scope scope(arena);
+            std::vector<Record> records;
+            for (int i = 0; i < 1000; ++i)
+            {
+                records.push_back(make_record(i));
+            }
+            EXPECT_EQ(records.back()[0]->as<int>(), 999);
+        }
+        EXPECT_GT(arena.allocated(), 0);
+        arena.reset();
+        EXPECT_EQ(arena.allocated(), 0);
+    }
+}
+
+TEST(RecordArenaTest, TestSelectInScope)
+{
+    MockDbClient client;
+    std::vector<Record> rows;
+    for (int i = 0; i < 10; ++i)
+    {
+        rows.push_back(make_record(i));
+    }
+    client.bulk_load("table", std::move(rows));
+
+    RecordArena arena;
+    {
+        RecordArena::Scope scope(arena);
+        const auto selected = client.select("table");
+        ASSERT_EQ(selected.size(), 10);
+        EXPECT_EQ(selected[7][1]->as<std::string>(), "name_7");
+    }
+    EXPECT_GT(arena.allocated(), 0);
+}
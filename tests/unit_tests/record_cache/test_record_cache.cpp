@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "record_cache.hpp"
+
+using namespace drug_lib::dao;
+
+namespace
+{
+    CacheSettings make_settings(const std::size_t capacity, const std::size_t shards,
+                                const std::chrono::milliseconds ttl = std::chrono::seconds(60))
+    {
+        CacheSettings settings;
+        settings.capacity = capacity;
+        settings.shards = shards;
+        settings.ttl = ttl;
+        return settings;
+    }
+}
+
+TEST(RecordCacheTest, TestInvalidSettings)
+{
+    EXPECT_THROW(RecordCache<int>(make_settings(0, 4)), std::invalid_argument);
+    EXPECT_THROW(RecordCache<int>(make_settings(4, 0)), std::invalid_argument);
+}
+
+TEST(RecordCacheTest, TestReadThrough)
+{
+    RecordCache<std::string> cache(make_settings(8, 2));
+    EXPECT_FALSE(cache.get("a").has_value());
+    cache.put("a", "Aspirin", cache.version("a"));
+    ASSERT_TRUE(cache.get("a").has_value());
+    EXPECT_EQ(cache.get("a").value(), "Aspirin");
+
+    const auto metrics = cache.metrics();
+    EXPECT_EQ(metrics.hits, 2);
+    EXPECT_EQ(metrics.misses, 1);
+    EXPECT_EQ(metrics.size, 1);
+    EXPECT_DOUBLE_EQ(metrics.hit_ratio(), 2. / 3.);
+}
+
+TEST(RecordCacheTest, TestLeastRecentlyUsedEvicted)
+{
+    RecordCache<int> cache(make_settings(2, 1));
+    cache.put("a", 1, cache.version("a"));
+    cache.put("b", 2, cache.version("b"));
+    EXPECT_TRUE(cache.get("a").has_value());
+    cache.put("c", 3, cache.version("c"));
+
+    EXPECT_TRUE(cache.get("a").has_value());
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_TRUE(cache.get("c").has_value());
+    EXPECT_EQ(cache.metrics().evictions, 1);
+    EXPECT_EQ(cache.metrics().size, 2);
+}
+
+TEST(RecordCacheTest, TestExpired)
+{
+    RecordCache<int> cache(make_settings(4, 1, std::chrono::milliseconds(10)));
+    cache.put("a", 1, cache.version("a"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(cache.get("a").has_value());
+    EXPECT_EQ(cache.metrics().size, 0);
+}
+
+TEST(RecordCacheTest, TestInvalidation)
+{
+    RecordCache<int> cache(make_settings(4, 1));
+    cache.put("a", 1, cache.version("a"));
+    cache.invalidate("a");
+    EXPECT_FALSE(cache.get("a").has_value());
+    EXPECT_EQ(cache.metrics().invalidations, 1);
+
+    cache.put("a", 1, cache.version("a"));
+    cache.put("b", 2, cache.version("b"));
+    cache.clear();
+    EXPECT_FALSE(cache.get("a").has_value());
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_EQ(cache.metrics().invalidations, 3);
+}
+
+TEST(RecordCacheTest, TestStaleReadDropped)
+{
+    RecordCache<int> cache(make_settings(4, 1));
+    // Read started before the write, its result comes after the invalidation
+    const auto version = cache.version("a");
+    cache.invalidate("a");
+    cache.put("a", 1, version);
+    EXPECT_FALSE(cache.get("a").has_value());
+}
+
+TEST(RecordCacheTest, TestConcurrentAccess)
+{
+    RecordCache<int> cache(make_settings(64, 8));
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&cache, t]
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                const std::string key = std::to_string((i + t) % 100);
+                if (const auto value = cache.get(key))
+                {
+                    EXPECT_EQ(*value, (i + t) % 100);
+                }
+                else
+                {
+                    cache.put(key, (i + t) % 100, cache.version(key));
+                }
+                if (i % 97 == 0)
+                {
+                    cache.invalidate(key);
+                }
+            }
+        });
+    }
+    threads.clear();
+    const auto metrics = cache.metrics();
+    EXPECT_EQ(metrics.hits + metrics.misses, 8000);
+    EXPECT_LE(metrics.size, 64);
+}
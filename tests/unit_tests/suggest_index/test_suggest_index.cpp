@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "suggest_index.hpp"
+
+using namespace drug_lib::services;
+
+namespace
+{
+    SuggestIndex make_index()
+    {
+        SuggestIndex index;
+        for (const auto* name : {"Aspirin", "Aspirin Cardio", "Ascorbic acid", "Paracetamol", "Ibuprofen", "Анальгин"})
+        {
+            index.add(name);
+        }
+        return index;
+    }
+}
+
+TEST(SuggestIndexTest, TestPrefix)
+{
+    const SuggestIndex index = make_index();
+    EXPECT_EQ(index.size(), 6);
+    EXPECT_EQ(index.suggest("as", 10, 0), (std::vector<std::string>{"Aspirin", "Ascorbic acid", "Aspirin Cardio"}));
+    EXPECT_EQ(index.suggest("ASP", 1, 0), (std::vector<std::string>{"Aspirin"}));
+    EXPECT_TRUE(index.suggest("asx", 10, 0).empty());
+    EXPECT_TRUE(index.suggest("", 10, 2).empty());
+}
+
+TEST(SuggestIndexTest, TestTypos)
+{
+    const SuggestIndex index = make_index();
+    // Substitution, transposition counted as two edits, missing and extra symbols
+    EXPECT_EQ(index.suggest("ibuprofan", 10, 1), (std::vector<std::string>{"Ibuprofen"}));
+    EXPECT_EQ(index.suggest("paractamol", 10, 1), (std::vector<std::string>{"Paracetamol"}));
+    EXPECT_EQ(index.suggest("asppirin", 10, 1), (std::vector<std::string>{"Aspirin", "Aspirin Cardio"}));
+    EXPECT_TRUE(index.suggest("ibuprfoen", 10, 1).empty());
+    EXPECT_EQ(index.suggest("ibuprfoen", 10, 2), (std::vector<std::string>{"Ibuprofen"}));
+    // Exact prefix goes before the close one
+    EXPECT_EQ(index.suggest("aspi", 10, 1).front(), "Aspirin");
+}
+
+TEST(SuggestIndexTest, TestCyrillic)
+{
+    const SuggestIndex index = make_index();
+    EXPECT_EQ(index.suggest("АНАЛ", 10, 0), (std::vector<std::string>{"Анальгин"}));
+    EXPECT_EQ(index.suggest("анольгин", 10, 1), (std::vector<std::string>{"Анальгин"}));
+}
+
+TEST(SuggestIndexTest, TestIncrementalUpdate)
+{
+    SuggestIndex index = make_index();
+    index.add("Aspirin");
+    index.remove("Aspirin");
+    EXPECT_EQ(index.suggest("aspirin", 10, 0).size(), 2);
+    index.remove("aspirin");
+    EXPECT_EQ(index.suggest("aspirin", 10, 0), (std::vector<std::string>{"Aspirin Cardio"}));
+    EXPECT_EQ(index.size(), 5);
+    index.remove("Unknown");
+    index.add("Aspirin");
+    EXPECT_EQ(index.suggest("aspirin", 10, 0).size(), 2);
+    EXPECT_EQ(index.size(), 6);
+}
+
+TEST(SuggestIndexTest, TestLargeCorpus)
+{
+    // Names share few first letters, so short patterns match thousands of them
+    std::mt19937 generator(7);
+    std::vector<std::string> names;
+    SuggestIndex index;
+    for (int i = 0; i < 50000; ++i)
+    {
+        std::string name(1, static_cast<char>('a' + generator() % 3));
+        const std::size_t length = 3 + generator() % 20;
+        while (name.size() < length)
+        {
+            name.push_back(static_cast<char>('a' + generator() % 26));
+        }
+        index.add(name);
+        names.push_back(std::move(name));
+    }
+    std::ranges::sort(names);
+    names.erase(std::ranges::unique(names).begin(), names.end());
+
+    // Prefix of the distance over the whole corpus, by the full table per name
+    const auto brute_force = [&names](const std::string& pattern, const std::size_t limit, const uint32_t max_distance)
+    {
+        std::vector<std::tuple<uint32_t, std::size_t, std::string>> matches;
+        for (const auto& name : names)
+        {
+            std::vector<uint32_t> previous(pattern.size() + 1);
+            std::iota(previous.begin(), previous.end(), 0u);
+            uint32_t best = previous.back();
+            for (std::size_t i = 1; i <= name.size(); ++i)
+            {
+                std::vector<uint32_t> row(pattern.size() + 1);
+                row[0] = static_cast<uint32_t>(i);
+                for (std::size_t j = 1; j <= pattern.size(); ++j)
+                {
+                    row[j] = std::min({previous[j] + 1, row[j - 1] + 1,
+                                       previous[j - 1] + (pattern[j - 1] == name[i - 1] ? 0u : 1u)});
+                }
+                best = std::min(best, row.back());
+                previous = std::move(row);
+            }
+            if (best <= max_distance)
+            {
+                matches.emplace_back(best, name.size(), name);
+            }
+        }
+        std::ranges::sort(matches);
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < std::min(limit, matches.size()); ++i)
+        {
+            result.push_back(std::get<2>(matches[i]));
+        }
+        return result;
+    };
+
+    for (const auto& [pattern, distance] : std::vector<std::pair<std::string, uint32_t>>{
+             {"a", 0}, {"b", 0}, {"ab", 0}, {"cqx", 0}, {"abcd", 1}, {"bxyzq", 1}, {"acetam", 2}
+         })
+    {
+        EXPECT_EQ(index.suggest(pattern, 10, distance), brute_force(pattern, 10, distance)) << pattern;
+    }
+}
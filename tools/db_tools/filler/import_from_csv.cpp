@@ -96,30 +96,30 @@ int main()
 	std::cout << patients[0]["birth_date"].isObject() << std::endl;
 	drug_lib::dao::SuperHandbook super_handbook;
 	super_handbook.establish_from_pool(db_pool);
-	for (const auto &record: meds)
+	std::vector<drug_lib::data::objects::Medicament> medicaments(meds.size());
+	for (std::size_t i = 0; i < meds.size(); ++i)
 	{
-		drug_lib::data::objects::Medicament medicament;
-		medicament.from_json(record);
-		super_handbook.medicaments().insert(medicament);
+		medicaments[i].from_json(meds[i]);
 	}
-	for (const auto &record: diseases)
+	super_handbook.medicaments().bulk_load(medicaments);
+	std::vector<drug_lib::data::objects::Disease> disease_objects(diseases.size());
+	for (std::size_t i = 0; i < diseases.size(); ++i)
 	{
-		drug_lib::data::objects::Disease disease;
-		disease.from_json(record);
-		super_handbook.diseases().insert(disease);
+		disease_objects[i].from_json(diseases[i]);
 	}
-	for (const auto &record: organizations)
+	super_handbook.diseases().bulk_load(disease_objects);
+	std::vector<drug_lib::data::objects::Organization> organization_objects(organizations.size());
+	for (std::size_t i = 0; i < organizations.size(); ++i)
 	{
-		drug_lib::data::objects::Organization organization;
-		organization.from_json(record);
-		super_handbook.organizations().insert(organization);
+		organization_objects[i].from_json(organizations[i]);
 	}
-	for (const auto& record : patients)
+	super_handbook.organizations().bulk_load(organization_objects);
+	std::vector<drug_lib::data::objects::Patient> patient_objects(patients.size());
+	for (std::size_t i = 0; i < patients.size(); ++i)
 	{
-		drug_lib::data::objects::Patient patient;
-		patient.from_json(record);
-		super_handbook.patients().insert((patient));
+		patient_objects[i].from_json(patients[i]);
 	}
+	super_handbook.patients().bulk_load(patient_objects);
 
 	return 0;
 }